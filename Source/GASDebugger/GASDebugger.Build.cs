@@ -27,6 +27,9 @@ public class GASDebugger : ModuleRules
 			// GAS modules (engine plugins)
 			"GameplayAbilities",
 			"GameplayTags",
+
+			// Synthetic load for the benchmarks
+			"GASDebuggerRuntime",
 		});
 
 		// Editor-only modules
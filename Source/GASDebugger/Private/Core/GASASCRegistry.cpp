@@ -0,0 +1,259 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASASCRegistry.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "EngineUtils.h"
+#include "Misc/ScopeLock.h"
+
+FGASASCRegistry::FGASASCRegistry(UWorld* InWorld)
+	: World(InWorld)
+{
+	RegisterListeners();
+	InitialScan();
+}
+
+FGASASCRegistry::~FGASASCRegistry()
+{
+	UnregisterListeners();
+}
+
+const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& FGASASCRegistry::GetComponents()
+{
+	FlushPendingComponents();
+	return Components;
+}
+
+void FGASASCRegistry::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Templates never live in a world
+	if (!Object || (Object->GetFlags() & (RF_ClassDefaultObject | RF_ArchetypeObject)))
+	{
+		return;
+	}
+
+	if (!Object->GetClass()->IsChildOf(UAbilitySystemComponent::StaticClass()))
+	{
+		return;
+	}
+
+	// The component is still being constructed, only remember it and resolve its world later
+	UAbilitySystemComponent* ASC = static_cast<UAbilitySystemComponent*>(const_cast<UObject*>(static_cast<const UObject*>(Object)));
+
+	FScopeLock Lock(&PendingLock);
+	PendingAdded.Add(ASC);
+}
+
+void FGASASCRegistry::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	// Called for every object the GC frees, reject the rest before taking the lock.
+	// The class is still valid here, unhashing the object walks its class chain right before this.
+	if (!Object || !Object->GetClass()->IsChildOf(UAbilitySystemComponent::StaticClass()))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PendingLock);
+	if (RegisteredIndices.Contains(Index))
+	{
+		bPruneRequested = true;
+	}
+}
+
+void FGASASCRegistry::OnUObjectArrayShutdown()
+{
+	UnregisterListeners();
+}
+
+void FGASASCRegistry::InitialScan()
+{
+	UWorld* WorldPtr = World.Get();
+	if (!WorldPtr)
+	{
+		return;
+	}
+
+	for (TActorIterator<AActor> It(WorldPtr); It; ++It)
+	{
+		AddActorComponents(*It);
+	}
+}
+
+void FGASASCRegistry::HandleActorSpawned(AActor* Actor)
+{
+	AddActorComponents(Actor);
+}
+
+void FGASASCRegistry::HandleActorDestroyed(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	TInlineComponentArray<UAbilitySystemComponent*> ActorComponents(Actor);
+	for (UAbilitySystemComponent* ASC : ActorComponents)
+	{
+		RemoveComponent(ASC);
+	}
+}
+
+void FGASASCRegistry::AddActorComponents(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// An actor may own more than one ASC
+	TInlineComponentArray<UAbilitySystemComponent*> ActorComponents(Actor);
+	for (UAbilitySystemComponent* ASC : ActorComponents)
+	{
+		AddComponent(ASC);
+	}
+}
+
+void FGASASCRegistry::AddComponent(UAbilitySystemComponent* ASC)
+{
+	if (!IsValid(ASC))
+	{
+		return;
+	}
+
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(ASC);
+	{
+		FScopeLock Lock(&PendingLock);
+		bool bAlreadyRegistered = false;
+		RegisteredIndices.Add(ObjectIndex, &bAlreadyRegistered);
+		if (bAlreadyRegistered)
+		{
+			return;
+		}
+	}
+
+	Components.Add(ASC);
+	++Version;
+}
+
+void FGASASCRegistry::RemoveComponent(const UAbilitySystemComponent* ASC)
+{
+	if (!ASC)
+	{
+		return;
+	}
+
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(ASC);
+	{
+		FScopeLock Lock(&PendingLock);
+		if (RegisteredIndices.Remove(ObjectIndex) == 0)
+		{
+			return;
+		}
+	}
+
+	Components.RemoveAll([ASC](const TWeakObjectPtr<UAbilitySystemComponent>& Entry)
+	{
+		return Entry.Get(true) == ASC;
+	});
+	++Version;
+}
+
+void FGASASCRegistry::FlushPendingComponents()
+{
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> Added;
+	bool bPrune = false;
+	{
+		FScopeLock Lock(&PendingLock);
+		if (PendingAdded.IsEmpty() && !bPruneRequested)
+		{
+			return;
+		}
+		Added = MoveTemp(PendingAdded);
+		bPrune = bPruneRequested;
+		bPruneRequested = false;
+	}
+
+	if (bPrune)
+	{
+		const int32 RemovedCount = Components.RemoveAll([](const TWeakObjectPtr<UAbilitySystemComponent>& Entry)
+		{
+			return !Entry.IsValid();
+		});
+
+		if (RemovedCount > 0)
+		{
+			FScopeLock Lock(&PendingLock);
+			RegisteredIndices.Reset();
+			for (const TWeakObjectPtr<UAbilitySystemComponent>& Entry : Components)
+			{
+				RegisteredIndices.Add(GUObjectArray.ObjectToIndex(Entry.Get()));
+			}
+			++Version;
+		}
+	}
+
+	UWorld* WorldPtr = World.Get();
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> StillPending;
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& Entry : Added)
+	{
+		UAbilitySystemComponent* ASC = Entry.Get();
+		if (!ASC || !WorldPtr || ASC->GetWorld() != WorldPtr)
+		{
+			continue;
+		}
+
+		// Created but not registered yet, check again on the next read
+		if (!ASC->IsRegistered())
+		{
+			StillPending.Add(Entry);
+			continue;
+		}
+
+		AddComponent(ASC);
+	}
+
+	if (StillPending.Num() > 0)
+	{
+		FScopeLock Lock(&PendingLock);
+		PendingAdded.Append(StillPending);
+	}
+}
+
+void FGASASCRegistry::RegisterListeners()
+{
+	UWorld* WorldPtr = World.Get();
+	if (!WorldPtr || bListenersRegistered)
+	{
+		return;
+	}
+
+	ActorSpawnedHandle = WorldPtr->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateRaw(this, &FGASASCRegistry::HandleActorSpawned));
+	ActorDestroyedHandle = WorldPtr->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateRaw(this, &FGASASCRegistry::HandleActorDestroyed));
+
+	GUObjectArray.AddUObjectCreateListener(this);
+	GUObjectArray.AddUObjectDeleteListener(this);
+	bListenersRegistered = true;
+}
+
+void FGASASCRegistry::UnregisterListeners()
+{
+	if (!bListenersRegistered)
+	{
+		return;
+	}
+
+	if (UWorld* WorldPtr = World.Get())
+	{
+		WorldPtr->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		WorldPtr->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	GUObjectArray.RemoveUObjectDeleteListener(this);
+	bListenersRegistered = false;
+}
@@ -0,0 +1,69 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+#include "HAL/CriticalSection.h"
+
+class AActor;
+class UAbilitySystemComponent;
+class UWorld;
+
+/**
+ * Per-world registry of AbilitySystemComponents.
+ * Filled by a single actor scan when created, then kept current from actor spawn/destroy
+ * and component create/delete notifications, so reading the list never walks the world.
+ */
+class FGASASCRegistry : public FUObjectCreateListener, public FUObjectDeleteListener
+{
+public:
+	explicit FGASASCRegistry(UWorld* InWorld);
+	virtual ~FGASASCRegistry();
+
+	/** Get the world this registry tracks */
+	UWorld* GetWorld() const { return World.Get(); }
+
+	/** Get all registered ASCs (applies pending component notifications first) */
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& GetComponents();
+
+	/** Incremented every time the registered set changes */
+	uint32 GetVersion() const { return Version; }
+
+	// FUObjectCreateListener / FUObjectDeleteListener interface
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+	/** Full scan, only run once when the registry is created */
+	void InitialScan();
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+
+	void AddComponent(UAbilitySystemComponent* ASC);
+	void RemoveComponent(const UAbilitySystemComponent* ASC);
+	void AddActorComponents(AActor* Actor);
+
+	/** Move components reported by the UObject listeners into the registered set */
+	void FlushPendingComponents();
+
+	void RegisterListeners();
+	void UnregisterListeners();
+
+private:
+	TWeakObjectPtr<UWorld> World;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> Components;
+	uint32 Version = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	bool bListenersRegistered = false;
+
+	/** UObject notifications can arrive from loading threads, everything below is guarded by PendingLock */
+	FCriticalSection PendingLock;
+	TSet<int32> RegisteredIndices;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> PendingAdded;
+	bool bPruneRequested = false;
+};
@@ -0,0 +1,74 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASAttributeModel.h"
+#include "Core/GASDebuggerStats.h"
+#include "GameplayEffectTypes.h"
+
+#define LOCTEXT_NAMESPACE "GASAttributeModel"
+
+namespace GASAttributeModel
+{
+	static void BuildModifierRow(const FGASModifierInfo& Info, const UEnum* OpEnum, FGASAttributeModifierRow& OutRow)
+	{
+		OutRow.Info = Info;
+
+		FString EffectName = Info.SourceEffectName.ToString();
+		// Remove "_C" suffix for Blueprint classes
+		if (EffectName.EndsWith(TEXT("_C")))
+		{
+			EffectName.LeftChopInline(2);
+		}
+		OutRow.EffectName = *EffectName;
+
+		OutRow.DisplayText = Info.StackCount > 1
+			? FText::Format(LOCTEXT("ModifierSourceStacks", "{0} (x{1})"), FText::FromName(OutRow.EffectName), FText::AsNumber(Info.StackCount))
+			: FText::FromName(OutRow.EffectName);
+
+		OutRow.OperationText = FText::Format(LOCTEXT("ModifierOpFormat", "Mod: {0}"),
+			FText::FromString(OpEnum->GetNameStringByValue(static_cast<int64>(Info.Operation))));
+		OutRow.MagnitudeText = FText::Format(LOCTEXT("ModifierMagnitudeFormat", "Value: {0}"),
+			FText::AsNumber(Info.Magnitude, &FNumberFormattingOptions::DefaultWithGrouping()));
+	}
+}
+
+void FGASAttributeModel::Build(const FGASAttributeCapture& Capture, FGASAttributeModel& OutModel)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_BuildAttributeModel);
+
+	OutModel.Rows.Reset(Capture.Attributes.Num());
+
+	const UEnum* OpEnum = StaticEnum<EGameplayModOp::Type>();
+
+	for (const FGASAttributeInfo& Info : Capture.Attributes)
+	{
+		// Case-insensitive fuzzy search
+		if (!Capture.SearchText.IsEmpty() && !Info.AttributeName.ToString().Contains(Capture.SearchText, ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+
+		FGASAttributeRow& Row = OutModel.Rows.AddDefaulted_GetRef();
+		Row.Info = Info;
+		Row.DisplayText = Info.AttributeName.IsNone()
+			? LOCTEXT("InvalidAttribute", "(Invalid)")
+			: FText::FromName(Info.AttributeName);
+		Row.BaseValueText = FText::Format(LOCTEXT("BaseFormat", "Base: {0}"),
+			FText::AsNumber(Info.BaseValue, &FNumberFormattingOptions::DefaultWithGrouping()));
+		Row.CurrentValueText = FText::Format(LOCTEXT("CurrentFormat", "Current: {0}"),
+			FText::AsNumber(Info.CurrentValue, &FNumberFormattingOptions::DefaultWithGrouping()));
+
+		if (const TArray<FGASModifierInfo>* Modifiers = Capture.Modifiers.Find(Info.Attribute))
+		{
+			Row.Modifiers.SetNum(Modifiers->Num());
+			for (int32 ModIdx = 0; ModIdx < Modifiers->Num(); ++ModIdx)
+			{
+				GASAttributeModel::BuildModifierRow((*Modifiers)[ModIdx], OpEnum, Row.Modifiers[ModIdx]);
+			}
+			INC_DWORD_STAT_BY(STAT_GASDebugger_BytesAllocated, Row.Modifiers.GetAllocatedSize());
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_GASDebugger_BytesAllocated, OutModel.Rows.GetAllocatedSize());
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,50 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GASDebuggerTypes.h"
+
+/**
+ * Everything the attributes tab displays, copied from the ASC on the game thread.
+ * Holds no references to live UObject state, so it can be handed to a worker thread.
+ */
+struct FGASAttributeCapture
+{
+	TArray<FGASAttributeInfo> Attributes;
+	FGASAttributeModifierIndex Modifiers;
+	FString SearchText;
+};
+
+/** Display-ready row of one modifier */
+struct FGASAttributeModifierRow
+{
+	FGASModifierInfo Info;
+	FName EffectName;
+	FText DisplayText;
+	FText OperationText;
+	FText MagnitudeText;
+};
+
+/** Display-ready row of one attribute */
+struct FGASAttributeRow
+{
+	FGASAttributeInfo Info;
+	FText DisplayText;
+	FText BaseValueText;
+	FText CurrentValueText;
+	TArray<FGASAttributeModifierRow> Modifiers;
+};
+
+/**
+ * Filtered, formatted attribute rows built from a capture.
+ * Built on a worker thread, then applied to the tree nodes on the game thread.
+ */
+struct FGASAttributeModel
+{
+	/** Attributes that passed the search filter, in capture order */
+	TArray<FGASAttributeRow> Rows;
+
+	/** Filter and format a capture, safe to run on any thread */
+	static void Build(const FGASAttributeCapture& Capture, FGASAttributeModel& OutModel);
+};
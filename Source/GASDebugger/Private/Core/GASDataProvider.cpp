@@ -1,13 +1,54 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Core/GASDataProvider.h"
+#include "Core/GASDebuggerStats.h"
+#include "Core/GASReflectionCache.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayAbilitySpec.h"
 #include "GameplayEffect.h"
 #include "AttributeSet.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+
+namespace GASDataProvider
+{
+	/** Replace the net index in the low bits of every entry with its full key, then sort */
+	static void KeyTagSnapshot(FGASTagSnapshot& Snapshot)
+	{
+		uint16 MaxNetIndex = 0;
+		for (const uint32 Entry : Snapshot.Entries)
+		{
+			MaxNetIndex = FMath::Max(MaxNetIndex, FGASTagSnapshot::GetNetIndex(Entry));
+		}
+
+		FGASReflectionCache& Cache = FGASReflectionCache::Get();
+		const TArray<uint16>& Ranks = Cache.GetTagLexicalRanks(MaxNetIndex);
+		for (uint32& Entry : Snapshot.Entries)
+		{
+			const uint16 NetIndex = FGASTagSnapshot::GetNetIndex(Entry);
+			Entry = (static_cast<uint32>(Ranks[NetIndex]) << 16) | NetIndex;
+		}
+
+		Snapshot.Entries.Sort();
+		Snapshot.RankVersion = Cache.GetTagRankVersion();
+	}
+
+	/** Describe one evaluated modifier of an active effect */
+	static void FillModifierInfo(FGASModifierInfo& Info, const FActiveGameplayEffect& ActiveEffect, int32 ModIdx)
+	{
+		const UGameplayEffect* Def = ActiveEffect.Spec.Def;
+		Info.Operation = Def->Modifiers[ModIdx].ModifierOp;
+		Info.SourceEffectClass = Def->GetClass();
+		Info.SourceEffectName = Def->GetClass()->GetFName();
+		Info.StackCount = ActiveEffect.Spec.GetStackCount();
+		Info.Magnitude = ActiveEffect.Spec.Modifiers[ModIdx].GetEvaluatedMagnitude();
+	}
+}
 
 TArray<FGASAbilityInfo> FGASDataProvider::GetGrantedAbilities(UAbilitySystemComponent* ASC)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_GetGrantedAbilities);
+
 	TArray<FGASAbilityInfo> Result;
 
 	if (!ASC)
@@ -48,6 +89,8 @@ TArray<FGASAbilityInfo> FGASDataProvider::GetGrantedAbilities(UAbilitySystemComp
 
 TArray<FGASEffectInfo> FGASDataProvider::GetActiveEffects(UAbilitySystemComponent* ASC)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureEffects);
+
 	TArray<FGASEffectInfo> Result;
 
 	if (!ASC)
@@ -55,43 +98,141 @@ TArray<FGASEffectInfo> FGASDataProvider::GetActiveEffects(UAbilitySystemComponen
 		return Result;
 	}
 
-	TArray<FActiveGameplayEffectHandle> ActiveHandles = ASC->GetActiveEffects(FGameplayEffectQuery());
+	// Iterate the container once, looking each handle up again would make this O(n^2)
+	const FActiveGameplayEffectsContainer& ActiveEffects = ASC->GetActiveGameplayEffects();
+	const UWorld* World = ASC->GetWorld();
+	const float WorldTime = World ? World->GetTimeSeconds() : 0.0f;
+	Result.Reserve(ActiveEffects.GetNumGameplayEffects());
 
-	for (const FActiveGameplayEffectHandle& Handle : ActiveHandles)
+	for (const FActiveGameplayEffect& ActiveEffect : &ActiveEffects)
 	{
-		const FActiveGameplayEffect* ActiveEffect = ASC->GetActiveGameplayEffect(Handle);
-		if (!ActiveEffect)
-		{
-			continue;
-		}
-
-		FGASEffectInfo Info;
-		Info.Handle = Handle;
-		Info.EffectClass = ActiveEffect->Spec.Def ? ActiveEffect->Spec.Def->GetClass() : nullptr;
-		Info.StackCount = ActiveEffect->Spec.GetStackCount();
-		Info.Level = ActiveEffect->Spec.GetLevel();
+		FGASEffectInfo& Info = Result.AddDefaulted_GetRef();
+		Info.Handle = ActiveEffect.Handle;
+		Info.EffectClass = ActiveEffect.Spec.Def ? ActiveEffect.Spec.Def->GetClass() : nullptr;
+		Info.StackCount = ActiveEffect.Spec.GetStackCount();
+		Info.Level = ActiveEffect.Spec.GetLevel();
 
 		// Duration info
-		float Duration = ActiveEffect->GetDuration();
+		float Duration = ActiveEffect.GetDuration();
 		if (Duration > 0.0f)
 		{
 			Info.Duration = Duration;
-			Info.TimeRemaining = ActiveEffect->GetTimeRemaining(ASC->GetWorld()->GetTimeSeconds());
+			Info.TimeRemaining = ActiveEffect.GetTimeRemaining(WorldTime);
 		}
 		else
 		{
 			Info.Duration = -1.0f; // Infinite
 			Info.TimeRemaining = -1.0f;
 		}
-
-		Result.Add(Info);
 	}
 
 	return Result;
 }
 
+void FGASDataProvider::CaptureEffectSnapshot(const FActiveGameplayEffect& Effect, FGASEffectSnapshot& OutSnapshot)
+{
+	const FGameplayEffectSpec& Spec = Effect.Spec;
+	const UGameplayEffect* Def = Spec.Def;
+
+	// Names derived from the definition are built once per definition, not per capture
+	const FGASEffectDefinitionInfo* DefInfo = Def ? &FGASReflectionCache::Get().GetEffectDefinitionInfo(Def) : nullptr;
+
+	OutSnapshot.Handle = Effect.Handle;
+	OutSnapshot.EffectClassName = DefInfo ? DefInfo->DisplayName : NAME_None;
+	OutSnapshot.Duration = Effect.GetDuration();
+	OutSnapshot.StartWorldTime = Effect.StartWorldTime;
+	OutSnapshot.StackCount = Spec.GetStackCount();
+	OutSnapshot.Level = Spec.GetLevel();
+
+	// Suppress deprecation warning - StackingType will be made private in future versions
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	OutSnapshot.bAggregateBySource = Def && Def->StackingType == EGameplayEffectStackingType::AggregateBySource;
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+	OutSnapshot.SourceName = NAME_None;
+	if (OutSnapshot.bAggregateBySource && OutSnapshot.StackCount > 1)
+	{
+		if (UAbilitySystemComponent* InstigatorASC = Spec.GetContext().GetInstigatorAbilitySystemComponent())
+		{
+			const AActor* Avatar = InstigatorASC->GetAvatarActor_Direct();
+			OutSnapshot.SourceName = Avatar ? Avatar->GetFName() : NAME_None;
+		}
+	}
+
+	if (Effect.PredictionKey.IsValidKey())
+	{
+		OutSnapshot.PredictionState = Effect.PredictionKey.WasLocallyGenerated()
+			? EGASEffectPredictionState::Waiting
+			: EGASEffectPredictionState::CaughtUp;
+	}
+	else
+	{
+		OutSnapshot.PredictionState = EGASEffectPredictionState::None;
+	}
+
+	// Same tags as FGameplayEffectSpec::GetAllGrantedTags, read in place instead of merged into a new container
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	OutSnapshot.GrantedTagIndices.Reset();
+	for (const FGameplayTag& Tag : Spec.DynamicGrantedTags)
+	{
+		OutSnapshot.GrantedTagIndices.AddUnique(TagsManager.GetNetIndexFromTag(Tag));
+	}
+	if (Def)
+	{
+		for (const FGameplayTag& Tag : Def->GetGrantedTags())
+		{
+			OutSnapshot.GrantedTagIndices.AddUnique(TagsManager.GetNetIndexFromTag(Tag));
+		}
+	}
+
+	// Spec modifiers are evaluated in the same order as the definition's
+	OutSnapshot.Modifiers.Reset();
+	if (Def)
+	{
+		const int32 NumModifiers = FMath::Min3(Spec.Modifiers.Num(), Def->Modifiers.Num(), DefInfo->ModifierAttributeNames.Num());
+		for (int32 ModIdx = 0; ModIdx < NumModifiers; ++ModIdx)
+		{
+			const FGameplayModifierInfo& ModInfo = Def->Modifiers[ModIdx];
+			FGASModifierSnapshot& Modifier = OutSnapshot.Modifiers.AddDefaulted_GetRef();
+			Modifier.AttributeName = DefInfo->ModifierAttributeNames[ModIdx];
+			Modifier.Operation = ModInfo.ModifierOp;
+			Modifier.Magnitude = Spec.Modifiers[ModIdx].GetEvaluatedMagnitude();
+		}
+	}
+}
+
+void FGASDataProvider::CaptureActiveEffects(UAbilitySystemComponent* ASC, TArray<FGASEffectSnapshot>& OutSnapshots)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureEffects);
+
+	if (!ASC)
+	{
+		OutSnapshots.Reset();
+		return;
+	}
+
+	// Shrinking keeps the allocations of the remaining snapshots and their inline arrays
+	const FActiveGameplayEffectsContainer& ActiveEffects = ASC->GetActiveGameplayEffects();
+	OutSnapshots.SetNum(ActiveEffects.GetNumGameplayEffects(), EAllowShrinking::No);
+
+	int32 NumCaptured = 0;
+	for (const FActiveGameplayEffect& ActiveEffect : &ActiveEffects)
+	{
+		if (NumCaptured == OutSnapshots.Num())
+		{
+			OutSnapshots.AddDefaulted();
+		}
+		CaptureEffectSnapshot(ActiveEffect, OutSnapshots[NumCaptured++]);
+	}
+
+	// The iterator skips pending removals, which GetNumGameplayEffects counts
+	OutSnapshots.SetNum(NumCaptured, EAllowShrinking::No);
+}
+
 FGameplayTagContainer FGASDataProvider::GetOwnedTags(UAbilitySystemComponent* ASC)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureTags);
+
 	FGameplayTagContainer Result;
 
 	if (ASC)
@@ -102,13 +243,138 @@ FGameplayTagContainer FGASDataProvider::GetOwnedTags(UAbilitySystemComponent* AS
 	return Result;
 }
 
+FGameplayTagContainer FGASDataProvider::GetBlockedAbilityTags(UAbilitySystemComponent* ASC)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureTags);
+
+	FGameplayTagContainer Result;
+
+	if (ASC)
+	{
+		ASC->GetBlockedAbilityTags(Result);
+	}
+
+	return Result;
+}
+
+void FGASDataProvider::CaptureTagBitset(const FGameplayTagContainer& Tags, FGASTagBitset& OutBits)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureTags);
+
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const FGameplayTagNetIndex InvalidNetIndex = TagsManager.GetInvalidTagNetIndex();
+
+	// Indices are looked up first so the parent table is only fetched once, covering all of them
+	TArray<FGameplayTagNetIndex, TInlineAllocator<32>> NetIndices;
+	uint16 MaxNetIndex = 0;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+		if (NetIndex != InvalidNetIndex)
+		{
+			NetIndices.Add(NetIndex);
+			MaxNetIndex = FMath::Max(MaxNetIndex, NetIndex);
+		}
+	}
+
+	const TArray<uint16>& Parents = FGASReflectionCache::Get().GetTagParentNetIndices(MaxNetIndex);
+	OutBits.Init(Parents.Num());
+
+	// Parent expansion is baked in, a query for A matches a container holding A.B
+	for (uint16 NetIndex : NetIndices)
+	{
+		while (NetIndex < Parents.Num() && !OutBits.HasBit(NetIndex))
+		{
+			OutBits.SetBit(NetIndex);
+			NetIndex = Parents[NetIndex];
+		}
+	}
+}
+
+void FGASDataProvider::CaptureTagSnapshot(const FGameplayTagContainer& Tags, FGASTagSnapshot& OutSnapshot)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureTags);
+
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const FGameplayTagNetIndex InvalidNetIndex = TagsManager.GetInvalidTagNetIndex();
+
+	OutSnapshot.Entries.Reset();
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+		if (NetIndex != InvalidNetIndex)
+		{
+			OutSnapshot.Entries.Add(NetIndex);
+		}
+	}
+
+	GASDataProvider::KeyTagSnapshot(OutSnapshot);
+}
+
+bool FGASDataProvider::DiffTagSnapshots(const FGASTagSnapshot& OldSnapshot, const FGASTagSnapshot& NewSnapshot, TArray<uint16>& OutAdded, TArray<uint16>& OutRemoved)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_DiffTags);
+
+	OutAdded.Reset();
+	OutRemoved.Reset();
+
+	// Net indices may have moved with the rank table, old entries can name different tags now
+	if (OldSnapshot.RankVersion != NewSnapshot.RankVersion)
+	{
+		return false;
+	}
+
+	// Both are sorted by the same keys, a single merge yields the exact difference
+	const TArray<uint32>& OldEntries = OldSnapshot.Entries;
+	const TArray<uint32>& NewEntries = NewSnapshot.Entries;
+	int32 OldIndex = 0;
+	int32 NewIndex = 0;
+	while (OldIndex < OldEntries.Num() && NewIndex < NewEntries.Num())
+	{
+		if (OldEntries[OldIndex] == NewEntries[NewIndex])
+		{
+			++OldIndex;
+			++NewIndex;
+		}
+		else if (OldEntries[OldIndex] < NewEntries[NewIndex])
+		{
+			OutRemoved.Add(FGASTagSnapshot::GetNetIndex(OldEntries[OldIndex++]));
+		}
+		else
+		{
+			OutAdded.Add(FGASTagSnapshot::GetNetIndex(NewEntries[NewIndex++]));
+		}
+	}
+
+	for (; OldIndex < OldEntries.Num(); ++OldIndex)
+	{
+		OutRemoved.Add(FGASTagSnapshot::GetNetIndex(OldEntries[OldIndex]));
+	}
+
+	for (; NewIndex < NewEntries.Num(); ++NewIndex)
+	{
+		OutAdded.Add(FGASTagSnapshot::GetNetIndex(NewEntries[NewIndex]));
+	}
+
+	return true;
+}
+
 TArray<FGASAttributeInfo> FGASDataProvider::GetAttributes(UAbilitySystemComponent* ASC)
 {
 	TArray<FGASAttributeInfo> Result;
+	CaptureAttributes(ASC, Result);
+	return Result;
+}
+
+void FGASDataProvider::CaptureAttributes(UAbilitySystemComponent* ASC, TArray<FGASAttributeInfo>& OutAttributes)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_CaptureAttributes);
+
+	OutAttributes.Reset();
 
 	if (!ASC)
 	{
-		return Result;
+		return;
 	}
 
 	// Get all spawned attributes from ASC
@@ -121,78 +387,106 @@ TArray<FGASAttributeInfo> FGASDataProvider::GetAttributes(UAbilitySystemComponen
 			continue;
 		}
 
-		FName SetName = AttrSet->GetClass()->GetFName();
+		// Offsets are resolved once per class, reading a value is a pointer offset
+		const FGASAttributeSetLayout& Layout = FGASReflectionCache::Get().GetAttributeSetLayout(AttrSet->GetClass());
+		OutAttributes.Reserve(OutAttributes.Num() + Layout.Attributes.Num());
 
-		// Iterate through all properties to find FGameplayAttributeData
-		for (TFieldIterator<FProperty> PropIt(AttrSet->GetClass()); PropIt; ++PropIt)
+		for (const FGASAttributeLayoutEntry& Entry : Layout.Attributes)
 		{
-			FProperty* Property = *PropIt;
-			if (!Property)
-			{
-				continue;
-			}
-
-			// Check if this is a gameplay attribute
-			FStructProperty* StructProperty = CastField<FStructProperty>(Property);
-			if (StructProperty && StructProperty->Struct == FGameplayAttributeData::StaticStruct())
-			{
-				FGameplayAttribute Attribute(Property);
-				if (Attribute.IsValid())
-				{
-					FGASAttributeInfo Info;
-					Info.Attribute = Attribute;
-					Info.AttributeSetName = SetName;
-					Info.BaseValue = ASC->GetNumericAttributeBase(Attribute);
-					Info.CurrentValue = ASC->GetNumericAttribute(Attribute);
-					Result.Add(Info);
-				}
-			}
+			const FGameplayAttributeData& Data = FGASAttributeSetLayout::GetData(AttrSet, Entry);
+
+			FGASAttributeInfo& Info = OutAttributes.AddDefaulted_GetRef();
+			Info.Attribute = Entry.Attribute;
+			Info.AttributeName = Entry.Name;
+			Info.AttributeSetName = Layout.SetName;
+			Info.BaseValue = Data.GetBaseValue();
+			Info.CurrentValue = Data.GetCurrentValue();
 		}
 	}
+}
 
-	return Result;
+bool FGASDataProvider::UpdateSpawnedAttributeSets(UAbilitySystemComponent* ASC, TArray<TObjectKey<UAttributeSet>>& InOutSets)
+{
+	const TArray<UAttributeSet*>& AttributeSets = ASC->GetSpawnedAttributes();
+
+	bool bChanged = AttributeSets.Num() != InOutSets.Num();
+	for (int32 Index = 0; !bChanged && Index < AttributeSets.Num(); ++Index)
+	{
+		bChanged = InOutSets[Index] != TObjectKey<UAttributeSet>(AttributeSets[Index]);
+	}
+
+	if (bChanged)
+	{
+		InOutSets.Reset(AttributeSets.Num());
+		for (UAttributeSet* AttrSet : AttributeSets)
+		{
+			InOutSets.Add(AttrSet);
+		}
+	}
+	return bChanged;
 }
 
 TArray<FGASModifierInfo> FGASDataProvider::GetAttributeModifiers(UAbilitySystemComponent* ASC, const FGameplayAttribute& Attribute)
 {
-	TArray<FGASModifierInfo> Result;
-
 	if (!ASC || !Attribute.IsValid())
 	{
-		return Result;
+		return TArray<FGASModifierInfo>();
 	}
 
-	// Get all active effects and check their modifiers
-	TArray<FActiveGameplayEffectHandle> ActiveHandles = ASC->GetActiveEffects(FGameplayEffectQuery());
-
-	for (const FActiveGameplayEffectHandle& Handle : ActiveHandles)
+	// One pass keeping only this attribute, callers that need several attributes should build the index once instead
+	TArray<FGASModifierInfo> Result;
+	const FActiveGameplayEffectsContainer& ActiveEffects = ASC->GetActiveGameplayEffects();
+	for (const FActiveGameplayEffect& ActiveEffect : &ActiveEffects)
 	{
-		const FActiveGameplayEffect* ActiveEffect = ASC->GetActiveGameplayEffect(Handle);
-		if (!ActiveEffect || !ActiveEffect->Spec.Def)
+		const UGameplayEffect* Def = ActiveEffect.Spec.Def;
+		if (!Def)
 		{
 			continue;
 		}
 
-		// Check each modifier in the effect
-		for (int32 ModIdx = 0; ModIdx < ActiveEffect->Spec.Def->Modifiers.Num(); ++ModIdx)
+		const int32 NumModifiers = FMath::Min(ActiveEffect.Spec.Modifiers.Num(), Def->Modifiers.Num());
+		for (int32 ModIdx = 0; ModIdx < NumModifiers; ++ModIdx)
 		{
-			const FGameplayModifierInfo& ModInfo = ActiveEffect->Spec.Def->Modifiers[ModIdx];
-			if (ModInfo.Attribute == Attribute)
+			if (Def->Modifiers[ModIdx].Attribute == Attribute)
 			{
-				FGASModifierInfo Info;
-				Info.Operation = ModInfo.ModifierOp;
-				Info.SourceEffectClass = ActiveEffect->Spec.Def->GetClass();
-				Info.StackCount = ActiveEffect->Spec.GetStackCount();
+				GASDataProvider::FillModifierInfo(Result.AddDefaulted_GetRef(), ActiveEffect, ModIdx);
+			}
+		}
+	}
+	return Result;
+}
+
+void FGASDataProvider::BuildAttributeModifierIndex(UAbilitySystemComponent* ASC, FGASAttributeModifierIndex& OutIndex)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_BuildModifierIndex);
 
-				// Get evaluated magnitude from the modifier info's magnitude calculation
-				float Magnitude = 0.0f;
-				ModInfo.ModifierMagnitude.AttemptCalculateMagnitude(ActiveEffect->Spec, Magnitude);
-				Info.Magnitude = Magnitude;
+	OutIndex.Reset();
 
-				Result.Add(Info);
+	if (!ASC)
+	{
+		return;
+	}
+
+	const FActiveGameplayEffectsContainer& ActiveEffects = ASC->GetActiveGameplayEffects();
+	for (const FActiveGameplayEffect& ActiveEffect : &ActiveEffects)
+	{
+		const UGameplayEffect* Def = ActiveEffect.Spec.Def;
+		if (!Def)
+		{
+			continue;
+		}
+
+		// Spec modifiers are evaluated in the same order as the definition's
+		const int32 NumModifiers = FMath::Min(ActiveEffect.Spec.Modifiers.Num(), Def->Modifiers.Num());
+		for (int32 ModIdx = 0; ModIdx < NumModifiers; ++ModIdx)
+		{
+			const FGameplayModifierInfo& ModInfo = Def->Modifiers[ModIdx];
+			if (!ModInfo.Attribute.IsValid())
+			{
+				continue;
 			}
+
+			GASDataProvider::FillModifierInfo(OutIndex.Modifiers.FindOrAdd(ModInfo.Attribute).AddDefaulted_GetRef(), ActiveEffect, ModIdx);
 		}
 	}
-
-	return Result;
 }
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
 #include "GASDebuggerTypes.h"
 
 class UAbilitySystemComponent;
+class UAttributeSet;
 
 /**
  * Provides access to GAS data from an AbilitySystemComponent
@@ -28,6 +30,20 @@ public:
 	 */
 	static TArray<FGASEffectInfo> GetActiveEffects(UAbilitySystemComponent* ASC);
 
+	/**
+	 * Extract the displayed data of an active effect
+	 * @param Effect The active effect to read
+	 * @param OutSnapshot Snapshot to overwrite, its storage is reused
+	 */
+	static void CaptureEffectSnapshot(const FActiveGameplayEffect& Effect, FGASEffectSnapshot& OutSnapshot);
+
+	/**
+	 * Extract the displayed data of all active effects
+	 * @param ASC The ability system component to query
+	 * @param OutSnapshots One snapshot per effect in container order, existing elements are overwritten to reuse their storage
+	 */
+	static void CaptureActiveEffects(UAbilitySystemComponent* ASC, TArray<FGASEffectSnapshot>& OutSnapshots);
+
 	/**
 	 * Get all owned gameplay tags from the ASC
 	 * @param ASC The ability system component to query
@@ -35,6 +51,37 @@ public:
 	 */
 	static FGameplayTagContainer GetOwnedTags(UAbilitySystemComponent* ASC);
 
+	/**
+	 * Get the tags blocking ability activation on the ASC
+	 * @param ASC The ability system component to query
+	 * @return Tag container with all blocked ability tags
+	 */
+	static FGameplayTagContainer GetBlockedAbilityTags(UAbilitySystemComponent* ASC);
+
+	/**
+	 * Key the tags of a container by lexical rank and net index
+	 * @param Tags The tags to capture
+	 * @param OutSnapshot Snapshot to overwrite, its storage is reused
+	 */
+	static void CaptureTagSnapshot(const FGameplayTagContainer& Tags, FGASTagSnapshot& OutSnapshot);
+
+	/**
+	 * Set the bits of the tags of a container and of all their parents
+	 * @param Tags The tags to capture
+	 * @param OutBits Bitset to overwrite, sized for every registered tag
+	 */
+	static void CaptureTagBitset(const FGameplayTagContainer& Tags, FGASTagBitset& OutBits);
+
+	/**
+	 * Merge two tag snapshots to find the exact tag changes between them
+	 * @param OldSnapshot Previous snapshot
+	 * @param NewSnapshot Current snapshot
+	 * @param OutAdded Net indices of tags only in the new snapshot, in name order
+	 * @param OutRemoved Net indices of tags only in the old snapshot, in name order
+	 * @return False if the tag dictionary changed in between, net indices of the old snapshot are then meaningless
+	 */
+	static bool DiffTagSnapshots(const FGASTagSnapshot& OldSnapshot, const FGASTagSnapshot& NewSnapshot, TArray<uint16>& OutAdded, TArray<uint16>& OutRemoved);
+
 	/**
 	 * Get all attributes from the ASC
 	 * @param ASC The ability system component to query
@@ -42,6 +89,21 @@ public:
 	 */
 	static TArray<FGASAttributeInfo> GetAttributes(UAbilitySystemComponent* ASC);
 
+	/**
+	 * Read all attributes from the ASC
+	 * @param ASC The ability system component to query
+	 * @param OutAttributes Array to fill, previous content is dropped
+	 */
+	static void CaptureAttributes(UAbilitySystemComponent* ASC, TArray<FGASAttributeInfo>& OutAttributes);
+
+	/**
+	 * Compare the spawned attribute sets of the ASC with the ones seen last time, the ASC has no event for them
+	 * @param ASC The ability system component to query
+	 * @param InOutSets Sets seen last time, updated when they changed
+	 * @return True when sets were added or removed since InOutSets was filled
+	 */
+	static bool UpdateSpawnedAttributeSets(UAbilitySystemComponent* ASC, TArray<TObjectKey<UAttributeSet>>& InOutSets);
+
 	/**
 	 * Get modifiers affecting a specific attribute
 	 * @param ASC The ability system component to query
@@ -49,4 +111,11 @@ public:
 	 * @return Array of modifier information
 	 */
 	static TArray<FGASModifierInfo> GetAttributeModifiers(UAbilitySystemComponent* ASC, const FGameplayAttribute& Attribute);
+
+	/**
+	 * Group the modifiers of all active effects by attribute in a single pass
+	 * @param ASC The ability system component to query
+	 * @param OutIndex Index to fill, previous content is dropped
+	 */
+	static void BuildAttributeModifierIndex(UAbilitySystemComponent* ASC, FGASAttributeModifierIndex& OutIndex);
 };
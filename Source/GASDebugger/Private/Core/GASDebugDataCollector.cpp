@@ -0,0 +1,226 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASDebugDataCollector.h"
+#include "Core/GASDataProvider.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectTypes.h"
+#include "Engine/World.h"
+
+void UGASDebugDataCollector::BeginDestroy()
+{
+	StopTracking();
+	Super::BeginDestroy();
+}
+
+void UGASDebugDataCollector::StartTracking(UAbilitySystemComponent* InASC)
+{
+	if (TrackedASC.Get() == InASC)
+	{
+		return;
+	}
+
+	StopTracking();
+
+	if (!IsValid(InASC))
+	{
+		return;
+	}
+
+	TrackedASC = InASC;
+	AllocateBuffers();
+
+	AbilityActivatedHandle = InASC->AbilityActivatedCallbacks.AddUObject(this, &UGASDebugDataCollector::HandleAbilityActivated);
+	AbilityEndedHandle = InASC->AbilityEndedCallbacks.AddUObject(this, &UGASDebugDataCollector::HandleAbilityEnded);
+	EffectAppliedHandle = InASC->OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UGASDebugDataCollector::HandleEffectApplied);
+	EffectRemovedHandle = InASC->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UGASDebugDataCollector::HandleEffectRemoved);
+	TagChangedHandle = InASC->RegisterGenericGameplayTagEvent().AddUObject(this, &UGASDebugDataCollector::HandleTagCountChanged);
+
+	FGASDataProvider::UpdateSpawnedAttributeSets(InASC, BoundAttributeSets);
+	BindAttributes(InASC);
+}
+
+void UGASDebugDataCollector::SyncAttributeBindings()
+{
+	UAbilitySystemComponent* ASC = TrackedASC.Get();
+	if (ASC && FGASDataProvider::UpdateSpawnedAttributeSets(ASC, BoundAttributeSets))
+	{
+		BindAttributes(ASC);
+	}
+}
+
+void UGASDebugDataCollector::BindAttributes(UAbilitySystemComponent* InASC)
+{
+	TArray<FGameplayAttribute> Attributes;
+	InASC->GetAllAttributes(Attributes);
+
+	// Attributes of removed sets are unbound, the others keep their binding
+	for (int32 Index = AttributeChangedHandles.Num() - 1; Index >= 0; --Index)
+	{
+		const TPair<FGameplayAttribute, FDelegateHandle>& Pair = AttributeChangedHandles[Index];
+		if (!Attributes.Contains(Pair.Key))
+		{
+			InASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value);
+			AttributeChangedHandles.RemoveAtSwap(Index);
+		}
+	}
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		if (!AttributeChangedHandles.ContainsByPredicate([&Attribute](const TPair<FGameplayAttribute, FDelegateHandle>& Pair) { return Pair.Key == Attribute; }))
+		{
+			FDelegateHandle Handle = InASC->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &UGASDebugDataCollector::HandleAttributeChanged);
+			AttributeChangedHandles.Emplace(Attribute, Handle);
+		}
+	}
+}
+
+void UGASDebugDataCollector::StopTracking()
+{
+	if (UAbilitySystemComponent* ASC = TrackedASC.Get())
+	{
+		ASC->AbilityActivatedCallbacks.Remove(AbilityActivatedHandle);
+		ASC->AbilityEndedCallbacks.Remove(AbilityEndedHandle);
+		ASC->OnActiveGameplayEffectAddedDelegateToSelf.Remove(EffectAppliedHandle);
+		ASC->OnAnyGameplayEffectRemovedDelegate().Remove(EffectRemovedHandle);
+		ASC->RegisterGenericGameplayTagEvent().Remove(TagChangedHandle);
+
+		for (const TPair<FGameplayAttribute, FDelegateHandle>& Pair : AttributeChangedHandles)
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value);
+		}
+	}
+
+	AbilityActivatedHandle.Reset();
+	AbilityEndedHandle.Reset();
+	EffectAppliedHandle.Reset();
+	EffectRemovedHandle.Reset();
+	TagChangedHandle.Reset();
+	AttributeChangedHandles.Reset();
+	BoundAttributeSets.Reset();
+	TrackedASC.Reset();
+}
+
+void UGASDebugDataCollector::ClearHistory()
+{
+	AbilityEvents.Reset();
+	EffectEvents.Reset();
+	TagEvents.Reset();
+	AttributeEvents.Reset();
+}
+
+SIZE_T UGASDebugDataCollector::GetHistoryAllocatedSize() const
+{
+	return AbilityEvents.GetAllocatedSize()
+		+ EffectEvents.GetAllocatedSize()
+		+ TagEvents.GetAllocatedSize()
+		+ AttributeEvents.GetAllocatedSize();
+}
+
+void UGASDebugDataCollector::AllocateBuffers()
+{
+	// Only reallocate when the configured limits changed, otherwise just drop the old history
+	if (AbilityEvents.GetCapacity() != MaxAbilityEvents)
+	{
+		AbilityEvents.Reserve(MaxAbilityEvents);
+	}
+	if (EffectEvents.GetCapacity() != MaxEffectEvents)
+	{
+		EffectEvents.Reserve(MaxEffectEvents);
+	}
+	if (TagEvents.GetCapacity() != MaxTagEvents)
+	{
+		TagEvents.Reserve(MaxTagEvents);
+	}
+	if (AttributeEvents.GetCapacity() != MaxAttributeEvents)
+	{
+		AttributeEvents.Reserve(MaxAttributeEvents);
+	}
+
+	ClearHistory();
+}
+
+double UGASDebugDataCollector::GetWorldTime() const
+{
+	const UAbilitySystemComponent* ASC = TrackedASC.Get();
+	const UWorld* World = ASC ? ASC->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UGASDebugDataCollector::HandleAbilityActivated(UGameplayAbility* Ability)
+{
+	PushAbilityEvent(Ability, true);
+}
+
+void UGASDebugDataCollector::HandleAbilityEnded(UGameplayAbility* Ability)
+{
+	PushAbilityEvent(Ability, false);
+}
+
+void UGASDebugDataCollector::PushAbilityEvent(UGameplayAbility* Ability, bool bActivated)
+{
+	if (!Ability)
+	{
+		return;
+	}
+
+	FGASDebugAbilityEvent Event;
+	Event.WorldTime = GetWorldTime();
+	Event.FrameNumber = GFrameCounter;
+	Event.Handle = Ability->GetCurrentAbilitySpecHandle();
+	Event.AbilityName = Ability->GetClass()->GetFName();
+	Event.bActivated = bActivated;
+	AbilityEvents.Push(Event);
+}
+
+void UGASDebugDataCollector::HandleEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	FGASDebugEffectEvent Event;
+	Event.WorldTime = GetWorldTime();
+	Event.FrameNumber = GFrameCounter;
+	Event.Handle = Handle;
+	Event.EffectName = Spec.Def ? Spec.Def->GetClass()->GetFName() : NAME_None;
+	Event.StackCount = Spec.GetStackCount();
+	Event.Level = Spec.GetLevel();
+	Event.Duration = Spec.GetDuration();
+	Event.bApplied = true;
+	EffectEvents.Push(Event);
+}
+
+void UGASDebugDataCollector::HandleEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	FGASDebugEffectEvent Event;
+	Event.WorldTime = GetWorldTime();
+	Event.FrameNumber = GFrameCounter;
+	Event.Handle = Effect.Handle;
+	Event.EffectName = Effect.Spec.Def ? Effect.Spec.Def->GetClass()->GetFName() : NAME_None;
+	Event.StackCount = Effect.Spec.GetStackCount();
+	Event.Level = Effect.Spec.GetLevel();
+	Event.Duration = Effect.GetDuration();
+	Event.bApplied = false;
+	EffectEvents.Push(Event);
+}
+
+void UGASDebugDataCollector::HandleTagCountChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	FGASDebugTagEvent Event;
+	Event.WorldTime = GetWorldTime();
+	Event.FrameNumber = GFrameCounter;
+	Event.Tag = Tag;
+	Event.NewCount = NewCount;
+	TagEvents.Push(Event);
+}
+
+void UGASDebugDataCollector::HandleAttributeChanged(const FOnAttributeChangeData& Data)
+{
+	const FProperty* Property = Data.Attribute.GetUProperty();
+
+	FGASDebugAttributeEvent Event;
+	Event.WorldTime = GetWorldTime();
+	Event.FrameNumber = GFrameCounter;
+	Event.AttributeName = Property ? Property->GetFName() : NAME_None;
+	Event.OldValue = Data.OldValue;
+	Event.NewValue = Data.NewValue;
+	AttributeEvents.Push(Event);
+}
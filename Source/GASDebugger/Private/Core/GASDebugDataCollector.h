@@ -0,0 +1,168 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayAbilitySpec.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "GameplayTagContainer.h"
+#include "AttributeSet.h"
+#include "UObject/ObjectKey.h"
+#include "Core/GASDebugRingBuffer.h"
+#include "GASDebugDataCollector.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+struct FActiveGameplayEffect;
+struct FGameplayEffectSpec;
+struct FOnAttributeChangeData;
+
+/** Ability activated/ended record */
+struct FGASDebugAbilityEvent
+{
+	double WorldTime = 0.0;
+	uint64 FrameNumber = 0;
+	FGameplayAbilitySpecHandle Handle;
+	FName AbilityName;
+	bool bActivated = false;
+};
+
+/** Effect applied/removed record */
+struct FGASDebugEffectEvent
+{
+	double WorldTime = 0.0;
+	uint64 FrameNumber = 0;
+	FActiveGameplayEffectHandle Handle;
+	FName EffectName;
+	int32 StackCount = 0;
+	float Level = 0.0f;
+	float Duration = 0.0f;
+	bool bApplied = false;
+};
+
+/** Tag count changed record */
+struct FGASDebugTagEvent
+{
+	double WorldTime = 0.0;
+	uint64 FrameNumber = 0;
+	FGameplayTag Tag;
+	int32 NewCount = 0;
+};
+
+/** Attribute value changed record */
+struct FGASDebugAttributeEvent
+{
+	double WorldTime = 0.0;
+	uint64 FrameNumber = 0;
+	FName AttributeName;
+	float OldValue = 0.0f;
+	float NewValue = 0.0f;
+};
+
+/**
+ * Records GAS events of the tracked ASC into bounded per-category histories.
+ * Limits come from [/Script/GASDebugger.GASDebugDataCollector] in DefaultGASDebugger.ini.
+ * All buffers are allocated when tracking starts, so event handlers never allocate.
+ */
+UCLASS(config=GASDebugger)
+class UGASDebugDataCollector : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Maximum number of ability execution events to store in history */
+	UPROPERTY(config)
+	int32 MaxAbilityEvents = 100;
+
+	/** Maximum number of effect application events to store in history */
+	UPROPERTY(config)
+	int32 MaxEffectEvents = 200;
+
+	/** Maximum number of tag change events to store in history */
+	UPROPERTY(config)
+	int32 MaxTagEvents = 500;
+
+	/** Maximum number of attribute change events to store in history */
+	UPROPERTY(config)
+	int32 MaxAttributeEvents = 200;
+
+	/** Update frequency in Hz (updates per second) */
+	UPROPERTY(config)
+	float UpdateFrequency = 1.0f;
+
+	/** Debugger cost allowed per frame in ms, 0 disables the budget */
+	UPROPERTY(config)
+	float FrameBudgetMs = 0.0f;
+
+	/** Memory the flight recorder may hold in MB, the oldest chunks are evicted above it */
+	UPROPERTY(config)
+	int32 RecorderMemoryCapMB = 100;
+
+	/** Maximum number of ASCs the flight recorder watches */
+	UPROPERTY(config)
+	int32 MaxRecordedASCs = 64;
+
+	/** Enable automatic event tracking when debug window is open */
+	UPROPERTY(config)
+	bool bAutoTrackingEnabled = true;
+
+	// UObject interface
+	virtual void BeginDestroy() override;
+
+	/** Start recording events from an ASC (stops tracking the previous one) */
+	void StartTracking(UAbilitySystemComponent* InASC);
+
+	/** Stop recording and unbind from the tracked ASC */
+	void StopTracking();
+
+	/** Rebind attributes when attribute sets were spawned or removed since tracking started */
+	void SyncAttributeBindings();
+
+	bool IsTracking() const { return TrackedASC.IsValid(); }
+	UAbilitySystemComponent* GetTrackedASC() const { return TrackedASC.Get(); }
+
+	/** Drop all recorded events, keeping the allocated storage */
+	void ClearHistory();
+
+	// History accessors
+	const TGASDebugRingBuffer<FGASDebugAbilityEvent>& GetAbilityEvents() const { return AbilityEvents; }
+	const TGASDebugRingBuffer<FGASDebugEffectEvent>& GetEffectEvents() const { return EffectEvents; }
+	const TGASDebugRingBuffer<FGASDebugTagEvent>& GetTagEvents() const { return TagEvents; }
+	const TGASDebugRingBuffer<FGASDebugAttributeEvent>& GetAttributeEvents() const { return AttributeEvents; }
+
+	/** Memory held by all histories */
+	SIZE_T GetHistoryAllocatedSize() const;
+
+private:
+	void AllocateBuffers();
+
+	/** Bind the attributes of the tracked ASC that are not bound yet, unbind the ones that are gone */
+	void BindAttributes(UAbilitySystemComponent* InASC);
+	double GetWorldTime() const;
+
+	void HandleAbilityActivated(UGameplayAbility* Ability);
+	void HandleAbilityEnded(UGameplayAbility* Ability);
+	void HandleEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void HandleEffectRemoved(const FActiveGameplayEffect& Effect);
+	void HandleTagCountChanged(const FGameplayTag Tag, int32 NewCount);
+	void HandleAttributeChanged(const FOnAttributeChangeData& Data);
+
+	void PushAbilityEvent(UGameplayAbility* Ability, bool bActivated);
+
+private:
+	TWeakObjectPtr<UAbilitySystemComponent> TrackedASC;
+
+	TGASDebugRingBuffer<FGASDebugAbilityEvent> AbilityEvents;
+	TGASDebugRingBuffer<FGASDebugEffectEvent> EffectEvents;
+	TGASDebugRingBuffer<FGASDebugTagEvent> TagEvents;
+	TGASDebugRingBuffer<FGASDebugAttributeEvent> AttributeEvents;
+
+	FDelegateHandle AbilityActivatedHandle;
+	FDelegateHandle AbilityEndedHandle;
+	FDelegateHandle EffectAppliedHandle;
+	FDelegateHandle EffectRemovedHandle;
+	FDelegateHandle TagChangedHandle;
+	TArray<TPair<FGameplayAttribute, FDelegateHandle>> AttributeChangedHandles;
+	TArray<TObjectKey<UAttributeSet>> BoundAttributeSets;
+};
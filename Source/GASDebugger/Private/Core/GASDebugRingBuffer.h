@@ -0,0 +1,74 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-capacity FIFO for debug event records.
+ * Storage is allocated once by Reserve(); Push() overwrites the oldest record and never allocates.
+ */
+template<typename EventType>
+class TGASDebugRingBuffer
+{
+public:
+	/** (Re)allocate storage for InCapacity records and drop existing history */
+	void Reserve(int32 InCapacity)
+	{
+		Capacity = FMath::Max(InCapacity, 0);
+		Events.Reset();
+		Events.SetNum(Capacity);
+		Head = 0;
+		Count = 0;
+	}
+
+	/** Append a record, evicting the oldest one when full */
+	void Push(const EventType& Event)
+	{
+		if (Capacity == 0)
+		{
+			return;
+		}
+
+		Events[Head] = Event;
+		Head = (Head + 1) % Capacity;
+		Count = FMath::Min(Count + 1, Capacity);
+	}
+
+	/** Drop all records, keeping the storage */
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+
+	int32 Num() const { return Count; }
+	int32 GetCapacity() const { return Capacity; }
+	bool IsEmpty() const { return Count == 0; }
+
+	/** Get a record by age, 0 is the oldest */
+	const EventType& operator[](int32 Index) const
+	{
+		check(Index >= 0 && Index < Count);
+		const int32 Oldest = (Head - Count + Capacity) % Capacity;
+		return Events[(Oldest + Index) % Capacity];
+	}
+
+	/** Visit records from oldest to newest */
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Func((*this)[Index]);
+		}
+	}
+
+	SIZE_T GetAllocatedSize() const { return Events.GetAllocatedSize(); }
+
+private:
+	TArray<EventType> Events;
+	int32 Head = 0;
+	int32 Count = 0;
+	int32 Capacity = 0;
+};
@@ -0,0 +1,513 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASDebuggerBenchmarkSuite.h"
+#include "GASDebuggerBenchmarkTypes.h"
+#include "Core/GASASCRegistry.h"
+#include "Core/GASAttributeModel.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASDebuggerSharedState.h"
+#include "Core/GASSnapshotStore.h"
+#include "Core/GASWorldService.h"
+#include "Widgets/Tabs/SGASDebuggerAbilityTab.h"
+#include "Widgets/Tabs/SGASDebuggerAttributesTab.h"
+#include "Widgets/Tabs/SGASDebuggerEffectsTab.h"
+#include "Widgets/Tabs/SGASDebuggerTagsTab.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Async/TaskGraphInterfaces.h"
+
+//////////////////////////////////////////////////////////////////////////
+// GASDebugger.Benchmark.ActiveEffects
+
+namespace GASDebuggerBenchmark
+{
+	/** Per effect cost growing more than this between N/4 and N effects is reported as non-linear */
+	static constexpr double MaxPerEffectCostRatio = 2.0;
+
+	static void RunActiveEffectsBenchmark(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		const int32 EffectCount = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500, 4);
+		const int32 Iterations = FMath::Max(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100, 1);
+
+		UWorld* World = FindBenchmarkWorld(InWorld);
+		UAbilitySystemComponent* ASC = SpawnSyntheticASC(World);
+		if (!ASC)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger benchmark: needs a PIE or game world"));
+			return;
+		}
+
+		UGameplayEffect* Effect = CreateSyntheticEffect();
+
+		Ar.Logf(TEXT("GASDebugger benchmark: active effect queries, %d iterations"), Iterations);
+		Ar.Logf(TEXT("%8s %14s %14s %14s"), TEXT("Effects"), TEXT("List us/eff"), TEXT("Index us/eff"), TEXT("Snap us/eff"));
+
+		const int32 Scales[] = { EffectCount / 4, EffectCount / 2, EffectCount };
+		double FirstPerEffect = 0.0;
+		double LastPerEffect = 0.0;
+
+		for (const int32 Scale : Scales)
+		{
+			ApplySyntheticEffects(ASC, Effect, Scale);
+			const int32 NumEffects = FMath::Max(ASC->GetActiveGameplayEffects().GetNumGameplayEffects(), 1);
+
+			const double ListTime = TimeMicroseconds(Iterations, [ASC]()
+			{
+				TArray<FGASEffectInfo> Effects = FGASDataProvider::GetActiveEffects(ASC);
+			});
+
+			FGASAttributeModifierIndex ModifierIndex;
+			const double IndexTime = TimeMicroseconds(Iterations, [ASC, &ModifierIndex]()
+			{
+				FGASDataProvider::BuildAttributeModifierIndex(ASC, ModifierIndex);
+			});
+
+			FGASEffectSnapshot Snapshot;
+			const double SnapshotTime = TimeMicroseconds(Iterations, [ASC, &Snapshot]()
+			{
+				for (const FActiveGameplayEffect& ActiveEffect : &ASC->GetActiveGameplayEffects())
+				{
+					FGASDataProvider::CaptureEffectSnapshot(ActiveEffect, Snapshot);
+				}
+			});
+
+			const double ListPerEffect = ListTime / NumEffects;
+			Ar.Logf(TEXT("%8d %14.3f %14.3f %14.3f"), NumEffects, ListPerEffect, IndexTime / NumEffects, SnapshotTime / NumEffects);
+
+			FirstPerEffect = (FirstPerEffect > 0.0) ? FirstPerEffect : ListPerEffect;
+			LastPerEffect = ListPerEffect;
+		}
+
+		const double Ratio = (FirstPerEffect > 0.0) ? LastPerEffect / FirstPerEffect : 0.0;
+		if (Ratio > MaxPerEffectCostRatio)
+		{
+			Ar.Logf(ELogVerbosity::Warning, TEXT("GASDebugger benchmark: per effect cost grew %.2fx from %d to %d effects, iteration is not linear"), Ratio, Scales[0], EffectCount);
+		}
+		else
+		{
+			Ar.Logf(TEXT("GASDebugger benchmark: per effect cost ratio %.2fx, linear"), Ratio);
+		}
+
+		DestroySyntheticASC(ASC);
+		Effect->MarkAsGarbage();
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice ActiveEffectsBenchmarkCommand(
+		TEXT("GASDebugger.Benchmark.ActiveEffects"),
+		TEXT("Time the active effect queries of the debugger against a synthetic ASC. Usage: GASDebugger.Benchmark.ActiveEffects [EffectCount=500] [Iterations=100]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunActiveEffectsBenchmark));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// GASDebugger.Benchmark.Suite
+
+namespace GASDebuggerBenchmark
+{
+	/** Regression threshold of one measurement: BaseUs plus PerItemUs per item, times the ThresholdScale argument */
+	struct FSuiteThreshold
+	{
+		const TCHAR* Name;
+		double BaseUs;
+		double PerItemUs;
+	};
+
+	/**
+	 * Defaults leave headroom for a development editor on a busy machine,
+	 * CI hardware with a known baseline can tighten them with ThresholdScale.
+	 */
+	static const FSuiteThreshold SuiteThresholds[] =
+	{
+		// Data provider queries, items are the entries returned over every ASC
+		{ TEXT("GetGrantedAbilities"), 100.0, 5.0 },
+		{ TEXT("GetActiveEffects"), 100.0, 5.0 },
+		{ TEXT("GetAttributes"), 100.0, 2.0 },
+		// One query per attribute, items are attributes times active effects
+		{ TEXT("GetAttributeModifiers"), 100.0, 0.5 },
+		// Items are ASCs
+		{ TEXT("RegistryScan"), 2000.0, 10.0 },
+		{ TEXT("RefreshASCList"), 50.0, 0.1 },
+		// Tab rebuilds of the selected ASC, items are the rows of the tab's category
+		{ TEXT("AbilityTab"), 2000.0, 50.0 },
+		{ TEXT("EffectsTab"), 2000.0, 50.0 },
+		{ TEXT("TagsTab"), 2000.0, 50.0 },
+		{ TEXT("AttributesTab"), 2000.0, 50.0 },
+		{ TEXT("AttributeModel"), 100.0, 20.0 },
+	};
+
+	/** ASC counts the suite measures, capped by MaxASCs */
+	static const int32 SuiteScales[] = { 1, 100, 1000, 10000 };
+
+	struct FSuiteMeasurement
+	{
+		FString Name;
+		int32 ASCs = 0;
+		int32 Items = 0;
+		double Microseconds = 0.0;
+		double ThresholdUs = 0.0;
+
+		/** Set when the measurement could not run in this session, e.g. the tabs without Slate */
+		bool bSkipped = false;
+
+		bool Passed() const { return bSkipped || Microseconds <= ThresholdUs; }
+	};
+
+	FSuiteArgs ParseSuiteArgs(const TArray<FString>& Args)
+	{
+		const FString Line = FString::Join(Args, TEXT(" "));
+
+		FSuiteArgs Result;
+		Result.OutputPath = FPaths::ProjectSavedDir() / TEXT("GASDebugger") / TEXT("Benchmark.json");
+
+		FParse::Value(*Line, TEXT("MaxASCs="), Result.MaxASCs);
+		FParse::Value(*Line, TEXT("Iterations="), Result.Iterations);
+		FParse::Value(*Line, TEXT("ThresholdScale="), Result.ThresholdScale);
+		FParse::Value(*Line, TEXT("Abilities="), Result.Content.Abilities);
+		FParse::Value(*Line, TEXT("Effects="), Result.Content.Effects);
+		FParse::Value(*Line, TEXT("Tags="), Result.Content.LooseTags);
+		FParse::Bool(*Line, TEXT("Attributes="), Result.Content.bAttributes);
+		FParse::Value(*Line, TEXT("Output="), Result.OutputPath);
+
+		Result.MaxASCs = FMath::Max(Result.MaxASCs, 1);
+		Result.Iterations = FMath::Max(Result.Iterations, 1);
+		Result.Content.Abilities = FMath::Max(Result.Content.Abilities, 0);
+		Result.Content.Effects = FMath::Max(Result.Content.Effects, 0);
+		Result.Content.LooseTags = FMath::Max(Result.Content.LooseTags, 0);
+		return Result;
+	}
+
+	static FSuiteMeasurement& AddMeasurement(TArray<FSuiteMeasurement>& Measurements, const FSuiteArgs& SuiteArgs, const TCHAR* Name, int32 NumASCs, int32 Items, double Microseconds)
+	{
+		FSuiteMeasurement& Measurement = Measurements.AddDefaulted_GetRef();
+		Measurement.Name = Name;
+		Measurement.ASCs = NumASCs;
+		Measurement.Items = Items;
+		Measurement.Microseconds = Microseconds;
+
+		for (const FSuiteThreshold& Threshold : SuiteThresholds)
+		{
+			if (FCString::Strcmp(Threshold.Name, Name) == 0)
+			{
+				Measurement.ThresholdUs = (Threshold.BaseUs + Threshold.PerItemUs * Items) * SuiteArgs.ThresholdScale;
+				break;
+			}
+		}
+		return Measurement;
+	}
+
+	static void AddSkipped(TArray<FSuiteMeasurement>& Measurements, const TCHAR* Name, int32 NumASCs)
+	{
+		FSuiteMeasurement& Measurement = Measurements.AddDefaulted_GetRef();
+		Measurement.Name = Name;
+		Measurement.ASCs = NumASCs;
+		Measurement.bSkipped = true;
+	}
+
+	/** Find the context handle of a world the debugger can select, the shared state only resolves PIE and Game worlds */
+	static bool FindContextHandle(FGASWorldService& WorldService, const UWorld* World, FName& OutHandle)
+	{
+		for (const FGASWorldContextInfo& Info : WorldService.GetWorldContexts())
+		{
+			if (Info.World.Get() == World)
+			{
+				OutHandle = Info.ContextHandle;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static FString SuiteResultsToJson(const FSuiteArgs& SuiteArgs, const TArray<FSuiteMeasurement>& Measurements, bool bPassed)
+	{
+		FString Json = TEXT("{\n");
+		Json += FString::Printf(TEXT("\t\"iterations\": %d,\n"), SuiteArgs.Iterations);
+		Json += FString::Printf(TEXT("\t\"abilities\": %d,\n"), SuiteArgs.Content.Abilities);
+		Json += FString::Printf(TEXT("\t\"effects\": %d,\n"), SuiteArgs.Content.Effects);
+		Json += FString::Printf(TEXT("\t\"tags\": %d,\n"), SuiteArgs.Content.LooseTags);
+		Json += FString::Printf(TEXT("\t\"attributes\": %d,\n"), SuiteArgs.Content.bAttributes ? UGASDebuggerBenchmarkAttributeSet::NumValues : 0);
+		Json += FString::Printf(TEXT("\t\"thresholdScale\": %.3f,\n"), SuiteArgs.ThresholdScale);
+		Json += FString::Printf(TEXT("\t\"passed\": %s,\n"), bPassed ? TEXT("true") : TEXT("false"));
+		Json += TEXT("\t\"results\": [\n");
+
+		for (int32 Index = 0; Index < Measurements.Num(); ++Index)
+		{
+			const FSuiteMeasurement& Measurement = Measurements[Index];
+			Json += FString::Printf(TEXT("\t\t{ \"name\": \"%s\", \"ascs\": %d, \"items\": %d, \"us\": %.3f, \"thresholdUs\": %.3f, \"skipped\": %s, \"passed\": %s }%s\n"),
+				*Measurement.Name, Measurement.ASCs, Measurement.Items, Measurement.Microseconds, Measurement.ThresholdUs,
+				Measurement.bSkipped ? TEXT("true") : TEXT("false"), Measurement.Passed() ? TEXT("true") : TEXT("false"),
+				Index + 1 < Measurements.Num() ? TEXT(",") : TEXT(""));
+		}
+
+		Json += TEXT("\t]\n}\n");
+		return Json;
+	}
+
+	/** Time a tab's rebuild of the selected ASC, as run by a refresh pass that marked its category dirty */
+	static double TimeTabRebuild(FGASDebuggerSharedState& SharedState, EGASDebugCategory Category, int32 Iterations)
+	{
+		return TimeMicroseconds(Iterations, [&SharedState, Category]()
+		{
+			// The store serves one capture per frame, drop it so every iteration pays like the first consumer of a frame
+			FGASSnapshotStore::Get().Reset();
+			SharedState.OnRefreshRequested.Broadcast(GASDebugCategoryBit(Category));
+		});
+	}
+
+	/** Pump the game thread queue until the attributes tab applied its model, which is built on a worker task */
+	static void WaitForAttributeModel(const SGASDebuggerAttributesTab& AttributesTab)
+	{
+		while (AttributesTab.IsModelBuildInFlight())
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		}
+	}
+
+	/** Time the attributes tab from capture to applied model, including the worker task and the hop back */
+	static double TimeAttributesTabRebuild(FGASDebuggerSharedState& SharedState, const SGASDebuggerAttributesTab& AttributesTab, int32 Iterations)
+	{
+		return TimeMicroseconds(Iterations, [&SharedState, &AttributesTab]()
+		{
+			FGASSnapshotStore::Get().Reset();
+			SharedState.OnRefreshRequested.Broadcast(GASDebugCategoryBit(EGASDebugCategory::Attributes));
+			WaitForAttributeModel(AttributesTab);
+		});
+	}
+
+	static void RunSuiteScale(const FSuiteArgs& SuiteArgs, UWorld* World, const TArray<UAbilitySystemComponent*>& ASCs, TArray<FSuiteMeasurement>& Measurements)
+	{
+		const int32 NumASCs = ASCs.Num();
+		const int32 Iterations = SuiteArgs.Iterations;
+		const int32 NumAttributes = SuiteArgs.Content.bAttributes ? UGASDebuggerBenchmarkAttributeSet::NumValues : 0;
+
+		// Data provider queries over every ASC, as a multi-ASC view would issue them
+		int32 NumAbilities = 0;
+		const double AbilitiesTime = TimeMicroseconds(Iterations, [&ASCs, &NumAbilities]()
+		{
+			NumAbilities = 0;
+			for (UAbilitySystemComponent* ASC : ASCs)
+			{
+				NumAbilities += FGASDataProvider::GetGrantedAbilities(ASC).Num();
+			}
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("GetGrantedAbilities"), NumASCs, NumAbilities, AbilitiesTime);
+
+		int32 NumEffects = 0;
+		const double EffectsTime = TimeMicroseconds(Iterations, [&ASCs, &NumEffects]()
+		{
+			NumEffects = 0;
+			for (UAbilitySystemComponent* ASC : ASCs)
+			{
+				NumEffects += FGASDataProvider::GetActiveEffects(ASC).Num();
+			}
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("GetActiveEffects"), NumASCs, NumEffects, EffectsTime);
+
+		int32 NumAttributeInfos = 0;
+		const double AttributesTime = TimeMicroseconds(Iterations, [&ASCs, &NumAttributeInfos]()
+		{
+			NumAttributeInfos = 0;
+			for (UAbilitySystemComponent* ASC : ASCs)
+			{
+				NumAttributeInfos += FGASDataProvider::GetAttributes(ASC).Num();
+			}
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("GetAttributes"), NumASCs, NumAttributeInfos, AttributesTime);
+
+		const double ModifiersTime = TimeMicroseconds(Iterations, [&ASCs, NumAttributes]()
+		{
+			for (UAbilitySystemComponent* ASC : ASCs)
+			{
+				for (int32 Index = 0; Index < NumAttributes; ++Index)
+				{
+					TArray<FGASModifierInfo> Modifiers = FGASDataProvider::GetAttributeModifiers(ASC, UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(Index));
+				}
+			}
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("GetAttributeModifiers"), NumASCs, NumASCs * NumAttributes * SuiteArgs.Content.Effects, ModifiersTime);
+
+		// A new registry walks the world once, the cost of opening a debugger window on it
+		const double ScanTime = TimeMicroseconds(Iterations, [World]()
+		{
+			FGASASCRegistry Registry(World);
+			Registry.GetComponents();
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("RegistryScan"), NumASCs, NumASCs, ScanTime);
+
+		// The window-facing part runs through a shared state, which only selects PIE and Game worlds
+		TSharedRef<FGASWorldService> WorldService = MakeShared<FGASWorldService>();
+		FName ContextHandle;
+		if (!FindContextHandle(*WorldService, World, ContextHandle))
+		{
+			AddSkipped(Measurements, TEXT("RefreshASCList"), NumASCs);
+			AddSkipped(Measurements, TEXT("AbilityTab"), NumASCs);
+			AddSkipped(Measurements, TEXT("EffectsTab"), NumASCs);
+			AddSkipped(Measurements, TEXT("TagsTab"), NumASCs);
+			AddSkipped(Measurements, TEXT("AttributesTab"), NumASCs);
+		}
+		else
+		{
+			TSharedRef<FGASDebuggerSharedState> SharedState = MakeShared<FGASDebuggerSharedState>(WorldService);
+			SharedState->SetSelectedWorld(ContextHandle);
+
+			// Warm the world's registry, the steady state of a refresh pass
+			SharedState->RefreshASCList();
+			const double RefreshTime = TimeMicroseconds(Iterations, [&SharedState]()
+			{
+				SharedState->RefreshASCList();
+			});
+			AddMeasurement(Measurements, SuiteArgs, TEXT("RefreshASCList"), NumASCs, SharedState->GetCachedASCList().Num(), RefreshTime);
+
+			if (!FSlateApplication::IsInitialized())
+			{
+				AddSkipped(Measurements, TEXT("AbilityTab"), NumASCs);
+				AddSkipped(Measurements, TEXT("EffectsTab"), NumASCs);
+				AddSkipped(Measurements, TEXT("TagsTab"), NumASCs);
+				AddSkipped(Measurements, TEXT("AttributesTab"), NumASCs);
+			}
+			else
+			{
+				// Tabs are built but never painted, only their model and tree item rebuild is measured
+				TSharedRef<SGASDebuggerAbilityTab> AbilityTab = SNew(SGASDebuggerAbilityTab).SharedState(SharedState);
+				TSharedRef<SGASDebuggerEffectsTab> EffectsTab = SNew(SGASDebuggerEffectsTab).SharedState(SharedState);
+				TSharedRef<SGASDebuggerTagsTab> TagsTab = SNew(SGASDebuggerTagsTab).SharedState(SharedState);
+				TSharedRef<SGASDebuggerAttributesTab> AttributesTab = SNew(SGASDebuggerAttributesTab).SharedState(SharedState);
+				SharedState->SetSelectedASC(ASCs.Last());
+
+				// The selection launched the first attribute model, it must not land inside a timed iteration
+				WaitForAttributeModel(*AttributesTab);
+
+				AddMeasurement(Measurements, SuiteArgs, TEXT("AbilityTab"), NumASCs, SuiteArgs.Content.Abilities,
+					TimeTabRebuild(*SharedState, EGASDebugCategory::Ability, Iterations));
+				AddMeasurement(Measurements, SuiteArgs, TEXT("EffectsTab"), NumASCs, SuiteArgs.Content.Effects,
+					TimeTabRebuild(*SharedState, EGASDebugCategory::GameplayEffects, Iterations));
+				AddMeasurement(Measurements, SuiteArgs, TEXT("TagsTab"), NumASCs, SuiteArgs.Content.LooseTags,
+					TimeTabRebuild(*SharedState, EGASDebugCategory::Tags, Iterations));
+				AddMeasurement(Measurements, SuiteArgs, TEXT("AttributesTab"), NumASCs, NumAttributes,
+					TimeAttributesTabRebuild(*SharedState, *AttributesTab, Iterations));
+
+				SharedState->SetSelectedASC(nullptr);
+			}
+		}
+
+		// The attributes tab's worker-thread half, without the capture
+		FGASAttributeCapture Capture;
+		FGASDataProvider::CaptureAttributes(ASCs.Last(), Capture.Attributes);
+		FGASDataProvider::BuildAttributeModifierIndex(ASCs.Last(), Capture.Modifiers);
+
+		FGASAttributeModel Model;
+		const double ModelTime = TimeMicroseconds(Iterations, [&Capture, &Model]()
+		{
+			FGASAttributeModel::Build(Capture, Model);
+		});
+		AddMeasurement(Measurements, SuiteArgs, TEXT("AttributeModel"), NumASCs, Capture.Attributes.Num(), ModelTime);
+	}
+
+	bool RunSuite(const FSuiteArgs& SuiteArgs, UWorld* World, FOutputDevice& Ar)
+	{
+		// Modifiers on the first attribute give the modifier queries something to find
+		UGameplayEffect* Effect = CreateSyntheticEffect(SuiteArgs.Content.bAttributes ? UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(0) : FGameplayAttribute());
+
+		TArray<FGameplayTag> Tags;
+		GetSyntheticTags(SuiteArgs.Content.LooseTags, Tags);
+		if (Tags.Num() < SuiteArgs.Content.LooseTags)
+		{
+			Ar.Logf(ELogVerbosity::Warning, TEXT("GASDebugger benchmark: only %d gameplay tags are registered, ASCs carry them instead of %d loose tags"), Tags.Num(), SuiteArgs.Content.LooseTags);
+		}
+
+		Ar.Logf(TEXT("GASDebugger benchmark suite: %d abilities, %d effects, %d tags, %s attribute set per ASC, %d iterations"),
+			SuiteArgs.Content.Abilities, SuiteArgs.Content.Effects, Tags.Num(), SuiteArgs.Content.bAttributes ? TEXT("with") : TEXT("no"), SuiteArgs.Iterations);
+
+		TArray<UAbilitySystemComponent*> ASCs;
+		TArray<FSuiteMeasurement> Measurements;
+
+		for (const int32 Scale : SuiteScales)
+		{
+			const int32 NumASCs = FMath::Min(Scale, SuiteArgs.MaxASCs);
+			if (NumASCs <= ASCs.Num())
+			{
+				continue;
+			}
+
+			// Scales grow the same population, each ASC is spawned once
+			while (ASCs.Num() < NumASCs)
+			{
+				UAbilitySystemComponent* ASC = SpawnSyntheticASC(World);
+				if (!ASC)
+				{
+					break;
+				}
+				PopulateSyntheticASC(ASC, SuiteArgs.Content, Effect, Tags);
+				ASCs.Add(ASC);
+			}
+
+			if (ASCs.Num() < NumASCs)
+			{
+				Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger benchmark: could only spawn %d of %d synthetic ASCs"), ASCs.Num(), NumASCs);
+				break;
+			}
+
+			RunSuiteScale(SuiteArgs, World, ASCs, Measurements);
+		}
+
+		bool bPassed = Measurements.Num() > 0;
+		Ar.Logf(TEXT("%-22s %8s %10s %14s %14s"), TEXT("Measurement"), TEXT("ASCs"), TEXT("Items"), TEXT("us"), TEXT("Threshold us"));
+		for (const FSuiteMeasurement& Measurement : Measurements)
+		{
+			if (Measurement.bSkipped)
+			{
+				Ar.Logf(TEXT("%-22s %8d %10s %14s %14s"), *Measurement.Name, Measurement.ASCs, TEXT("-"), TEXT("skipped"), TEXT("-"));
+			}
+			else if (Measurement.Passed())
+			{
+				Ar.Logf(TEXT("%-22s %8d %10d %14.3f %14.3f"), *Measurement.Name, Measurement.ASCs, Measurement.Items, Measurement.Microseconds, Measurement.ThresholdUs);
+			}
+			else
+			{
+				Ar.Logf(ELogVerbosity::Error, TEXT("%-22s %8d %10d %14.3f %14.3f over threshold"), *Measurement.Name, Measurement.ASCs, Measurement.Items, Measurement.Microseconds, Measurement.ThresholdUs);
+				bPassed = false;
+			}
+		}
+
+		const FString Json = SuiteResultsToJson(SuiteArgs, Measurements, bPassed);
+		if (FFileHelper::SaveStringToFile(Json, *SuiteArgs.OutputPath))
+		{
+			Ar.Logf(TEXT("GASDebugger benchmark: results written to %s"), *SuiteArgs.OutputPath);
+		}
+		else
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger benchmark: could not write %s"), *SuiteArgs.OutputPath);
+		}
+		Ar.Logf(TEXT("GASDebugger benchmark suite %s"), bPassed ? TEXT("passed") : TEXT("FAILED"));
+
+		for (UAbilitySystemComponent* ASC : ASCs)
+		{
+			DestroySyntheticASC(ASC);
+		}
+		Effect->MarkAsGarbage();
+		return bPassed;
+	}
+
+	static void RunBenchmarkSuite(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		UWorld* World = FindBenchmarkWorld(InWorld);
+		if (!World)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger benchmark: needs a PIE or game world"));
+			return;
+		}
+
+		RunSuite(ParseSuiteArgs(Args), World, Ar);
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchmarkSuiteCommand(
+		TEXT("GASDebugger.Benchmark.Suite"),
+		TEXT("Time the debugger's queries, ASC list and tab rebuilds against 1, 100, 1000 and 10000 synthetic ASCs and write JSON results with regression thresholds. ")
+		TEXT("Usage: GASDebugger.Benchmark.Suite [MaxASCs=10000] [Iterations=10] [Abilities=10] [Effects=10] [Tags=10] [Attributes=true] [ThresholdScale=1] [Output=<path>]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunBenchmarkSuite));
+}
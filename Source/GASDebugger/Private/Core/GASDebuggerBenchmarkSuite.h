@@ -0,0 +1,36 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GASDebuggerBenchmark.h"
+
+class FOutputDevice;
+class UWorld;
+
+/**
+ * Benchmark suite of the debugger's queries, ASC list and tab rebuilds.
+ * Run by the GASDebugger.Benchmark.Suite console command and the GASDebugger.Benchmark.Suite automation test.
+ */
+namespace GASDebuggerBenchmark
+{
+	struct FSuiteArgs
+	{
+		int32 MaxASCs = 10000;
+		int32 Iterations = 10;
+		float ThresholdScale = 1.0f;
+		FSyntheticASCConfig Content;
+		FString OutputPath;
+	};
+
+	/** Parse Key=Value arguments, e.g. MaxASCs=1000 Iterations=5 Output=<path> */
+	FSuiteArgs ParseSuiteArgs(const TArray<FString>& Args);
+
+	/**
+	 * Measure every scale up to MaxASCs with synthetic ASCs spawned into World, log the results and write them as JSON
+	 * @param World Game or PIE world, the ASC list and tab measurements are skipped when the debugger cannot select it
+	 * @param Ar Output of the results table, measurements over their threshold are logged as errors
+	 * @return True when every measurement stayed within its regression threshold
+	 */
+	bool RunSuite(const FSuiteArgs& SuiteArgs, UWorld* World, FOutputDevice& Ar);
+}
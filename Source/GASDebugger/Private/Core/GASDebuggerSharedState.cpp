@@ -1,45 +1,58 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Core/GASDebuggerSharedState.h"
-#include "Engine/Engine.h"
+#include "Core/GASDebuggerStats.h"
+#include "Core/GASASCRegistry.h"
+#include "Core/GASWorldService.h"
+#include "Core/GASDebugDataCollector.h"
+#include "Core/GASSnapshotStore.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASFlightRecorder.h"
 #include "Engine/World.h"
+#include "HAL/PlatformTime.h"
 #include "AbilitySystemComponent.h"
-#include "GameFramework/Actor.h"
-#include "EngineUtils.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayEffect.h"
+#include "GameplayTagsModule.h"
 
-FGASDebuggerSharedState::FGASDebuggerSharedState()
+namespace GASDebuggerSharedState
 {
+	/** Exponential moving average, the first sample initializes it */
+	static double Smooth(double Average, double Sample)
+	{
+		return Average > 0.0 ? FMath::Lerp(Average, Sample, 0.1) : Sample;
+	}
 }
 
-UWorld* FGASDebuggerSharedState::GetSelectedWorld() const
+FGASDebuggerSharedState::FGASDebuggerSharedState(TSharedRef<FGASWorldService> InWorldService)
+	: WorldService(InWorldService)
 {
-	if (!GEngine)
-	{
-		return nullptr;
-	}
+	DataCollector = TStrongObjectPtr<UGASDebugDataCollector>(NewObject<UGASDebugDataCollector>());
+	WorldsChangedHandle = WorldService->OnWorldsChanged.AddRaw(this, &FGASDebuggerSharedState::HandleWorldsChanged);
+	TagTreeChangedHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddRaw(this, &FGASDebuggerSharedState::HandleGameplayTagTreeChanged);
+}
+
+FGASDebuggerSharedState::~FGASDebuggerSharedState()
+{
+	WorldService->OnWorldsChanged.Remove(WorldsChangedHandle);
+	IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(TagTreeChangedHandle);
 
-	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-	for (const FWorldContext& Context : WorldList)
+	if (DataCollector.IsValid())
 	{
-		if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
-		{
-			if (Context.ContextHandle == SelectedWorldContextHandle)
-			{
-				return Context.World();
-			}
-		}
+		DataCollector->StopTracking();
 	}
+	UnbindDirtyTracking();
+}
 
-	// Return first valid world if no specific selection
-	for (const FWorldContext& Context : WorldList)
+UWorld* FGASDebuggerSharedState::GetSelectedWorld() const
+{
+	if (!bSelectedWorldResolved)
 	{
-		if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
-		{
-			return Context.World();
-		}
+		const FGASWorldContextInfo* Context = WorldService->FindWorldContext(SelectedWorldContextHandle);
+		SelectedWorld = Context ? Context->World : nullptr;
+		bSelectedWorldResolved = true;
 	}
-
-	return nullptr;
+	return SelectedWorld.Get();
 }
 
 void FGASDebuggerSharedState::SetSelectedWorld(FName InWorldContextHandle)
@@ -47,8 +60,10 @@ void FGASDebuggerSharedState::SetSelectedWorld(FName InWorldContextHandle)
 	if (SelectedWorldContextHandle != InWorldContextHandle)
 	{
 		SelectedWorldContextHandle = InWorldContextHandle;
+		bSelectedWorldResolved = false;
 		SelectedASC.Reset();
 		RefreshASCList();
+		HandleSelectedASCChanged();
 		OnSelectionChanged.Broadcast();
 	}
 }
@@ -63,6 +78,7 @@ void FGASDebuggerSharedState::SetSelectedASC(TWeakObjectPtr<UAbilitySystemCompon
 	if (SelectedASC != InASC)
 	{
 		SelectedASC = InASC;
+		HandleSelectedASCChanged();
 		OnSelectionChanged.Broadcast();
 	}
 }
@@ -74,35 +90,515 @@ void FGASDebuggerSharedState::SetPickingMode(bool bEnabled)
 
 void FGASDebuggerSharedState::RequestRefresh()
 {
+	bRefreshPending = true;
+	DirtyCategories = GASDebugAllCategories;
+}
+
+void FGASDebuggerSharedState::Tick()
+{
+	AccountRecorderCost();
+
+	// Several widgets may tick us in the same frame, only one pass per frame
+	if (LastRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	// Over budget: skip refreshes until the frames since the last pass paid for it, which lowers the refresh rate
+	const float BudgetMs = GetFrameBudgetMs();
+	if (BudgetMs > 0.f)
+	{
+		BudgetDebtMs = FMath::Max(BudgetDebtMs - BudgetMs * static_cast<double>(GFrameCounter - LastBudgetFrame), 0.0);
+		LastBudgetFrame = GFrameCounter;
+		if (BudgetDebtMs > 0.0)
+		{
+			return;
+		}
+	}
+	else
+	{
+		BudgetDebtMs = 0.0;
+	}
+
+	// A recording of the tag query matches needs them rematched even when nothing selected changed
+	const bool bRecordingMatches = bHasActorTagQuery && FGASFlightRecorder::Get().IsRecordingFrom(*this);
+
+	const double Now = FPlatformTime::Seconds();
+	const double RefreshInterval = GetRefreshInterval();
+	const bool bPeriodicRefreshDue = (bPickingMode || bRecordingMatches) && (Now - LastRefreshTime) >= RefreshInterval;
+
+	// Without periodic passes, attribute sets are still checked at the refresh rate, a change queues a pass
+	if (!bPeriodicRefreshDue && !bRefreshPending && (Now - LastAttributeSyncTime) >= RefreshInterval)
+	{
+		LastAttributeSyncTime = Now;
+		bRefreshPending = SyncAttributeBindings();
+	}
+
+	if (bRefreshPending || bPeriodicRefreshDue)
+	{
+		LastRefreshTime = Now;
+		ExecuteRefresh();
+	}
+}
+
+void FGASDebuggerSharedState::AccountRecorderCost()
+{
+	const FGASFlightRecorder& Recorder = FGASFlightRecorder::Get();
+	if (!Recorder.IsRecordingFrom(*this))
+	{
+		Overhead.RecordMs = 0.0;
+		return;
+	}
+
+	if (Recorder.GetLastRecordedFrame() == RecorderCostFrame)
+	{
+		return;
+	}
+	RecorderCostFrame = Recorder.GetLastRecordedFrame();
+
+	// Recording never skips a frame, its cost is paid off by refreshing less often
+	Overhead.RecordMs = GASDebuggerSharedState::Smooth(Overhead.RecordMs, Recorder.GetLastFrameCostMs());
+	if (GetFrameBudgetMs() > 0.f)
+	{
+		BudgetDebtMs += Recorder.GetLastFrameCostMs();
+	}
+}
+
+double FGASDebuggerSharedState::GetRefreshInterval() const
+{
+	const float UpdateFrequency = DataCollector.IsValid() ? DataCollector->UpdateFrequency : 1.0f;
+	return UpdateFrequency > UE_SMALL_NUMBER ? 1.0 / UpdateFrequency : 1.0;
+}
+
+void FGASDebuggerSharedState::ExecuteRefresh()
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshPass);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double StartCaptureSeconds = FGASSnapshotStore::Get().GetCaptureSeconds();
+	PassStartTime = StartTime;
+
+	bRefreshPending = false;
+	LastRefreshFrame = GFrameCounter;
+	LastAttributeSyncTime = StartTime;
+
+	if (bWorldChangePending)
+	{
+		bWorldChangePending = false;
+		HandleSelectedWorldChanged();
+	}
+
 	RefreshASCList();
-	OnRefreshRequested.Broadcast();
+	SyncAttributeBindings();
+
+	// Actors start and stop matching as their tags change, the recorder follows the new matches through RecordedASCsVersion
+	if (bHasActorTagQuery)
+	{
+		GetFilteredASCList();
+	}
+
+	// Tabs skip their rebuild when their category is clean
+	const uint8 Categories = DirtyCategories;
+	DirtyCategories = 0;
+	OnRefreshRequested.Broadcast(Categories);
+
+	// Categories deferred by this pass go first in the next one
+	CarriedCategories = DeferredCategories;
+	DeferredCategories = 0;
+	PassStartTime = 0.0;
+
+	LastRefreshCostMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	AverageRefreshCostMs = GASDebuggerSharedState::Smooth(AverageRefreshCostMs, LastRefreshCostMs);
+
+	const double CaptureMs = (FGASSnapshotStore::Get().GetCaptureSeconds() - StartCaptureSeconds) * 1000.0;
+	Overhead.CaptureMs = GASDebuggerSharedState::Smooth(Overhead.CaptureMs, CaptureMs);
+	Overhead.ModelBuildMs = GASDebuggerSharedState::Smooth(Overhead.ModelBuildMs, FMath::Max(LastRefreshCostMs - CaptureMs, 0.0));
+	Overhead.HistoryBytes = DataCollector.IsValid() ? DataCollector->GetHistoryAllocatedSize() : 0;
+
+	if (GetFrameBudgetMs() > 0.f)
+	{
+		BudgetDebtMs += LastRefreshCostMs;
+	}
+}
+
+void FGASDebuggerSharedState::AddPaintCost(double Seconds)
+{
+	// The previous frame is complete once a widget paints in a new one
+	if (PaintFrame != GFrameCounter)
+	{
+		if (PaintFrame != 0)
+		{
+			Overhead.PaintMs = GASDebuggerSharedState::Smooth(Overhead.PaintMs, PaintFrameSeconds * 1000.0);
+		}
+		PaintFrame = GFrameCounter;
+		PaintFrameSeconds = 0.0;
+	}
+	PaintFrameSeconds += Seconds;
+}
+
+float FGASDebuggerSharedState::GetFrameBudgetMs() const
+{
+	return DataCollector.IsValid() ? FMath::Max(DataCollector->FrameBudgetMs, 0.f) : 0.f;
+}
+
+void FGASDebuggerSharedState::SetFrameBudgetMs(float InBudgetMs)
+{
+	if (DataCollector.IsValid())
+	{
+		DataCollector->FrameBudgetMs = FMath::Max(InBudgetMs, 0.f);
+	}
+}
+
+bool FGASDebuggerSharedState::ShouldDeferRefresh(EGASDebugCategory Category)
+{
+	const float BudgetMs = GetFrameBudgetMs();
+	if (BudgetMs <= 0.f || PassStartTime <= 0.0)
+	{
+		return false;
+	}
+
+	// Categories carried over from the last pass always run, so no tab starves behind a slower one
+	const uint8 CategoryBit = GASDebugCategoryBit(Category);
+	if ((CarriedCategories & CategoryBit) != 0)
+	{
+		return false;
+	}
+
+	if ((FPlatformTime::Seconds() - PassStartTime) * 1000.0 < BudgetMs)
+	{
+		return false;
+	}
+
+	DeferredCategories |= CategoryBit;
+	DirtyCategories |= CategoryBit;
+	bRefreshPending = true;
+	return true;
 }
 
 void FGASDebuggerSharedState::RefreshASCList()
 {
-	CachedASCList.Reset();
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshASCList);
 
 	UWorld* World = GetSelectedWorld();
 	if (!World)
+	{
+		ASCRegistry.Reset();
+		return;
+	}
+
+	// Other windows on the same world share the registry
+	if (!ASCRegistry.IsValid() || ASCRegistry->GetWorld() != World)
+	{
+		ASCRegistry = WorldService->GetRegistry(World);
+	}
+
+	// Auto-select first ASC if no current selection
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Components = ASCRegistry->GetComponents();
+	if (!SelectedASC.IsValid() && Components.Num() > 0)
+	{
+		SelectedASC = Components[0];
+		HandleSelectedASCChanged();
+	}
+}
+
+const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& FGASDebuggerSharedState::GetCachedASCList() const
+{
+	static const TArray<TWeakObjectPtr<UAbilitySystemComponent>> EmptyList;
+	return ASCRegistry.IsValid() ? ASCRegistry->GetComponents() : EmptyList;
+}
+
+void FGASDebuggerSharedState::SetActorTagQuery(const FGameplayTagQuery& InQuery)
+{
+	bHasActorTagQuery = !InQuery.IsEmpty();
+	ActorTagQuerySource = InQuery;
+	ActorTagQuery = FGASTagBitQuery::Compile(InQuery);
+
+	// Match right away, the recorder follows the last matches
+	FilteredASCList.Reset();
+	if (bHasActorTagQuery)
+	{
+		GetFilteredASCList();
+	}
+	++RecordedASCsVersion;
+}
+
+const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& FGASDebuggerSharedState::GetFilteredASCList()
+{
+	if (!bHasActorTagQuery)
+	{
+		return GetCachedASCList();
+	}
+
+	// Tags change all the time, capture them fresh, then match every ASC with word-wise bit tests
+	ActorTagIndex.Capture(GetCachedASCList());
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> PreviousList = MoveTemp(FilteredASCList);
+	ActorTagIndex.Query(ActorTagQuery, FilteredASCList);
+	if (FilteredASCList != PreviousList)
+	{
+		++RecordedASCsVersion;
+	}
+	return FilteredASCList;
+}
+
+void FGASDebuggerSharedState::GetRecordedASCs(TArray<TWeakObjectPtr<UAbilitySystemComponent>>& OutASCs) const
+{
+	OutASCs.Reset();
+	if (SelectedASC.IsValid())
+	{
+		OutASCs.Add(SelectedASC);
+	}
+	if (bHasActorTagQuery)
+	{
+		for (const TWeakObjectPtr<UAbilitySystemComponent>& ASC : FilteredASCList)
+		{
+			if (ASC != SelectedASC)
+			{
+				OutASCs.Add(ASC);
+			}
+		}
+	}
+}
+
+void FGASDebuggerSharedState::HandleWorldsChanged()
+{
+	// Called in the middle of world setup and teardown, only invalidate here and let the next Tick react
+	bSelectedWorldResolved = false;
+	bWorldChangePending = true;
+	ASCRegistry.Reset();
+	RequestRefresh();
+}
+
+void FGASDebuggerSharedState::HandleGameplayTagTreeChanged()
+{
+	// The compiled masks hold net indices, which move when tags are added or removed
+	ActorTagQuery = FGASTagBitQuery::Compile(ActorTagQuerySource);
+	RequestRefresh();
+}
+
+void FGASDebuggerSharedState::HandleSelectedWorldChanged()
+{
+	UWorld* World = GetSelectedWorld();
+	const UAbilitySystemComponent* ASC = SelectedASC.Get();
+	if (ASC && ASC->GetWorld() == World)
 	{
 		return;
 	}
 
-	for (TActorIterator<AActor> It(World); It; ++It)
+	// The selection belonged to a world that ended, tabs drop their nodes and pick up the new world
+	SelectedASC.Reset();
+	RefreshASCList();
+	HandleSelectedASCChanged();
+	OnSelectionChanged.Broadcast();
+}
+
+void FGASDebuggerSharedState::HandleSelectedASCChanged()
+{
+	++RecordedASCsVersion;
+
+	if (DataCollector.IsValid() && DataCollector->bAutoTrackingEnabled)
+	{
+		DataCollector->StartTracking(SelectedASC.Get());
+	}
+
+	if (DirtyTrackedASC != SelectedASC)
+	{
+		UnbindDirtyTracking();
+		BindDirtyTracking(SelectedASC.Get());
+		DirtyCategories = GASDebugAllCategories;
+	}
+}
+
+void FGASDebuggerSharedState::BindDirtyTracking(UAbilitySystemComponent* InASC)
+{
+	if (!IsValid(InASC))
+	{
+		return;
+	}
+
+	DirtyTrackedASC = InASC;
+	EffectAddedHandle = InASC->OnActiveGameplayEffectAddedDelegateToSelf.AddSP(this, &FGASDebuggerSharedState::HandleEffectAdded);
+	EffectRemovedHandle = InASC->OnAnyGameplayEffectRemovedDelegate().AddSP(this, &FGASDebuggerSharedState::HandleEffectRemoved);
+	TagChangedHandle = InASC->RegisterGenericGameplayTagEvent().AddSP(this, &FGASDebuggerSharedState::HandleTagCountChanged);
+	AbilityActivatedHandle = InASC->AbilityActivatedCallbacks.AddSP(this, &FGASDebuggerSharedState::HandleAbilityChanged);
+	AbilityEndedHandle = InASC->AbilityEndedCallbacks.AddSP(this, &FGASDebuggerSharedState::HandleAbilityChanged);
+	AbilitySpecDirtiedHandle = InASC->AbilitySpecDirtiedCallbacks.AddSP(this, &FGASDebuggerSharedState::HandleAbilitySpecDirtied);
+
+	for (const FActiveGameplayEffect& Effect : &InASC->GetActiveGameplayEffects())
+	{
+		BindEffectEvents(InASC, Effect.Handle);
+	}
+
+	FGASDataProvider::UpdateSpawnedAttributeSets(InASC, BoundAttributeSets);
+	BindAttributes(InASC);
+}
+
+void FGASDebuggerSharedState::BindAttributes(UAbilitySystemComponent* InASC)
+{
+	TArray<FGameplayAttribute> Attributes;
+	InASC->GetAllAttributes(Attributes);
+
+	// Attributes of removed sets are unbound, the others keep their binding
+	for (int32 Index = AttributeChangedHandles.Num() - 1; Index >= 0; --Index)
+	{
+		const TPair<FGameplayAttribute, FDelegateHandle>& Pair = AttributeChangedHandles[Index];
+		if (!Attributes.Contains(Pair.Key))
+		{
+			InASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value);
+			AttributeChangedHandles.RemoveAtSwap(Index);
+		}
+	}
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		if (!AttributeChangedHandles.ContainsByPredicate([&Attribute](const TPair<FGameplayAttribute, FDelegateHandle>& Pair) { return Pair.Key == Attribute; }))
+		{
+			FDelegateHandle Handle = InASC->GetGameplayAttributeValueChangeDelegate(Attribute).AddSP(this, &FGASDebuggerSharedState::HandleAttributeChanged);
+			AttributeChangedHandles.Emplace(Attribute, Handle);
+		}
+	}
+}
+
+bool FGASDebuggerSharedState::SyncAttributeBindings()
+{
+	UAbilitySystemComponent* ASC = DirtyTrackedASC.Get();
+	if (!ASC || !FGASDataProvider::UpdateSpawnedAttributeSets(ASC, BoundAttributeSets))
+	{
+		return false;
+	}
+
+	// Attribute sets were spawned or removed after the selection, bind their attributes and show them.
+	// The collector tracks the same selected ASC, it only compares its own sets when these changed.
+	BindAttributes(ASC);
+	if (DataCollector.IsValid())
+	{
+		DataCollector->SyncAttributeBindings();
+	}
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::Attributes)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability));
+	return true;
+}
+
+void FGASDebuggerSharedState::UnbindDirtyTracking()
+{
+	if (UAbilitySystemComponent* ASC = DirtyTrackedASC.Get())
 	{
-		AActor* Actor = *It;
-		if (Actor)
+		ASC->OnActiveGameplayEffectAddedDelegateToSelf.Remove(EffectAddedHandle);
+		ASC->OnAnyGameplayEffectRemovedDelegate().Remove(EffectRemovedHandle);
+		ASC->RegisterGenericGameplayTagEvent().Remove(TagChangedHandle);
+		ASC->AbilityActivatedCallbacks.Remove(AbilityActivatedHandle);
+		ASC->AbilityEndedCallbacks.Remove(AbilityEndedHandle);
+		ASC->AbilitySpecDirtiedCallbacks.Remove(AbilitySpecDirtiedHandle);
+
+		for (const TPair<FActiveGameplayEffectHandle, FEffectEventHandles>& Pair : EffectEventHandles)
 		{
-			if (UAbilitySystemComponent* ASC = Actor->FindComponentByClass<UAbilitySystemComponent>())
+			if (FActiveGameplayEffectEvents* Events = ASC->GetActiveEffectEventSet(Pair.Key))
 			{
-				CachedASCList.Add(ASC);
+				Events->OnStackChanged.Remove(Pair.Value.StackChanged);
+				Events->OnTimeChanged.Remove(Pair.Value.TimeChanged);
 			}
 		}
+
+		for (const TPair<FGameplayAttribute, FDelegateHandle>& Pair : AttributeChangedHandles)
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value);
+		}
 	}
 
-	// Auto-select first ASC if no current selection
-	if (!SelectedASC.IsValid() && CachedASCList.Num() > 0)
+	EffectEventHandles.Reset();
+	AttributeChangedHandles.Reset();
+	BoundAttributeSets.Reset();
+	AttributeVersions.Reset();
+	DirtyTrackedASC.Reset();
+}
+
+void FGASDebuggerSharedState::BindEffectEvents(UAbilitySystemComponent* InASC, FActiveGameplayEffectHandle Handle)
+{
+	FActiveGameplayEffectEvents* Events = InASC->GetActiveEffectEventSet(Handle);
+	if (!Events || EffectEventHandles.Contains(Handle))
 	{
-		SelectedASC = CachedASCList[0];
+		return;
 	}
+
+	FEffectEventHandles& Handles = EffectEventHandles.Add(Handle);
+	Handles.StackChanged = Events->OnStackChanged.AddSP(this, &FGASDebuggerSharedState::HandleEffectStackChanged);
+	Handles.TimeChanged = Events->OnTimeChanged.AddSP(this, &FGASDebuggerSharedState::HandleEffectTimeChanged);
+}
+
+FGASAbilityStateVersions FGASDebuggerSharedState::GetAbilityStateVersions() const
+{
+	FGASAbilityStateVersions Versions;
+	Versions.OwnedTags = OwnedTagsVersion;
+	Versions.Effects = EffectsVersion;
+	Versions.Attributes = &AttributeVersions;
+	return Versions;
+}
+
+void FGASDebuggerSharedState::HandleEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	// Effects drive cooldowns and costs (abilities) and modifiers (attributes)
+	if (UAbilitySystemComponent* ASC = DirtyTrackedASC.Get())
+	{
+		BindEffectEvents(ASC, Handle);
+	}
+
+	++EffectsVersion;
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::GameplayEffects)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability)
+		| GASDebugCategoryBit(EGASDebugCategory::Attributes));
+}
+
+void FGASDebuggerSharedState::HandleEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	// The effect's event set goes away with it
+	EffectEventHandles.Remove(Effect.Handle);
+
+	++EffectsVersion;
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::GameplayEffects)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability)
+		| GASDebugCategoryBit(EGASDebugCategory::Attributes));
+}
+
+void FGASDebuggerSharedState::HandleEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 NewStackCount, int32 PreviousStackCount)
+{
+	// Stacks scale modifiers, and can change the cooldown or cost an ability sees
+	++EffectsVersion;
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::GameplayEffects)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability)
+		| GASDebugCategoryBit(EGASDebugCategory::Attributes));
+}
+
+void FGASDebuggerSharedState::HandleEffectTimeChanged(FActiveGameplayEffectHandle Handle, float NewStartTime, float NewDuration)
+{
+	// A refreshed or extended duration moves the remaining time, and with it cooldowns
+	++EffectsVersion;
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::GameplayEffects)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability));
+}
+
+void FGASDebuggerSharedState::HandleTagCountChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	// Tags gate ability activation
+	++OwnedTagsVersion;
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::Tags)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability));
+}
+
+void FGASDebuggerSharedState::HandleAttributeChanged(const FOnAttributeChangeData& Data)
+{
+	// Attributes gate ability costs, abilities only recheck when an attribute their cost modifies moved
+	++AttributeVersions.FindOrAdd(Data.Attribute);
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::Attributes)
+		| GASDebugCategoryBit(EGASDebugCategory::Ability));
+}
+
+void FGASDebuggerSharedState::HandleAbilityChanged(UGameplayAbility* Ability)
+{
+	// Activation blocks and unblocks the ability's ActivationBlockedTags, which no tag event reports
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::Ability)
+		| GASDebugCategoryBit(EGASDebugCategory::Tags));
+}
+
+void FGASDebuggerSharedState::HandleAbilitySpecDirtied(const FGameplayAbilitySpec& Spec)
+{
+	MarkDirty(GASDebugCategoryBit(EGASDebugCategory::Ability));
 }
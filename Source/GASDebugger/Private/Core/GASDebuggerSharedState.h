@@ -4,6 +4,33 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/ObjectKey.h"
+#include "GASDebuggerTypes.h"
+#include "Core/GASTagQuery.h"
+
+class FGASASCRegistry;
+class FGASWorldService;
+class UGASDebugDataCollector;
+
+/** Cost of the debugger itself, smoothed over recent passes and frames */
+struct FGASDebuggerOverhead
+{
+	/** Snapshot captures of a refresh pass */
+	double CaptureMs = 0.0;
+
+	/** Rest of a refresh pass: ASC list, node and model updates */
+	double ModelBuildMs = 0.0;
+
+	/** Slate paint of the top bar and the tabs in one frame */
+	double PaintMs = 0.0;
+
+	/** Flight recorder frame, while it records this window's ASCs */
+	double RecordMs = 0.0;
+
+	/** Memory held by the event histories */
+	SIZE_T HistoryBytes = 0;
+};
 
 /**
  * Shared state class for GASDebugger tabs.
@@ -13,14 +40,20 @@ class FGASDebuggerSharedState : public TSharedFromThis<FGASDebuggerSharedState>
 {
 public:
 	DECLARE_MULTICAST_DELEGATE(FOnSelectionChanged);
-	DECLARE_MULTICAST_DELEGATE(FOnRefreshRequested);
+	/** Broadcast once per refresh pass with the mask of categories whose GAS data changed */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnRefreshRequested, uint8 /*DirtyCategories*/);
 
 	FOnSelectionChanged OnSelectionChanged;
 	FOnRefreshRequested OnRefreshRequested;
 
-	FGASDebuggerSharedState();
+	explicit FGASDebuggerSharedState(TSharedRef<FGASWorldService> InWorldService);
+	~FGASDebuggerSharedState();
+
+	/** World lookups and ASC registries shared with the other windows */
+	FGASWorldService& GetWorldService() const { return *WorldService; }
 
 	// World selection
+	/** Resolved once after each selection change or world event, a weak pointer read otherwise */
 	UWorld* GetSelectedWorld() const;
 	FName GetSelectedWorldContextHandle() const { return SelectedWorldContextHandle; }
 	void SetSelectedWorld(FName InWorldContextHandle);
@@ -33,16 +66,176 @@ public:
 	bool IsPickingMode() const { return bPickingMode; }
 	void SetPickingMode(bool bEnabled);
 
-	// Refresh
+	// Refresh scheduling
+	/** Queue a full refresh, all requests made before the next Tick are coalesced into one pass */
 	void RequestRefresh();
 
-	// ASC list management
+	/** Mark categories as changed, they are refreshed by the next pass */
+	void MarkDirty(uint8 InCategories) { DirtyCategories |= InCategories; }
+
+	/** Change counters of the selected ASC the ability states depend on, BlockedTags is left to the caller */
+	FGASAbilityStateVersions GetAbilityStateVersions() const;
+
+	/** Add the flight recorder's last frame to the overhead and the frame budget, once per recorded frame */
+	void AccountRecorderCost();
+
+	/** Run the pending refresh pass, or a periodic one in Tick mode at the configured UpdateFrequency */
+	void Tick();
+
+	/** Measured cost of the last refresh pass */
+	double GetLastRefreshCostMs() const { return LastRefreshCostMs; }
+
+	/** Smoothed refresh pass cost */
+	double GetAverageRefreshCostMs() const { return AverageRefreshCostMs; }
+
+	// Overhead and frame budget
+	const FGASDebuggerOverhead& GetOverhead() const { return Overhead; }
+
+	/** Add the paint time of one of this window's widgets to the current frame */
+	void AddPaintCost(double Seconds);
+
+	/** Debugger cost allowed per frame in ms, 0 when the budget is off */
+	float GetFrameBudgetMs() const;
+	void SetFrameBudgetMs(float InBudgetMs);
+
+	/** True while refreshes are held back to pay off passes that went over the budget */
+	bool IsThrottled() const { return BudgetDebtMs > 0.0; }
+
+	/**
+	 * Called by a tab before its refresh. Once the running pass used up the frame budget the tab's
+	 * category stays dirty and is refreshed by the next pass; a category deferred once is never deferred twice in a row.
+	 */
+	bool ShouldDeferRefresh(EGASDebugCategory Category);
+
+	// ASC list management (backed by the event-driven registry the world service keeps per world)
 	void RefreshASCList();
-	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& GetCachedASCList() const { return CachedASCList; }
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& GetCachedASCList() const;
+
+	// Actor filtering by owned tags
+	/** Set the query the actor list is filtered by, an empty query shows every actor */
+	void SetActorTagQuery(const FGameplayTagQuery& InQuery);
+	bool HasActorTagQuery() const { return bHasActorTagQuery; }
+
+	/** ASCs of the cached list whose owned tags match the actor tag query, recaptured on every call */
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& GetFilteredASCList();
+
+	// Flight recorder targets
+	/** ASCs this window records: the selected one first, then the last tag query matches */
+	void GetRecordedASCs(TArray<TWeakObjectPtr<UAbilitySystemComponent>>& OutASCs) const;
+
+	/** Bumped whenever the selection, the tag query or its matches change */
+	uint32 GetRecordedASCsVersion() const { return RecordedASCsVersion; }
+
+	// Event history of the selected ASC
+	UGASDebugDataCollector* GetDataCollector() const { return DataCollector.Get(); }
 
 private:
+	/** Retarget the data collector and the dirty-tracking callbacks to the current selection */
+	void HandleSelectedASCChanged();
+
+	// Dirty tracking from ASC callbacks
+	void BindDirtyTracking(UAbilitySystemComponent* InASC);
+	void UnbindDirtyTracking();
+
+	/** Bind the attributes of the tracked ASC that are not bound yet, unbind the ones that are gone */
+	void BindAttributes(UAbilitySystemComponent* InASC);
+
+	/**
+	 * Rebind attributes when attribute sets were spawned or removed, the ASC has no event for it.
+	 * Checked by every refresh pass, and at the refresh rate when there are no periodic passes.
+	 * @return True when the sets changed, attributes and abilities are marked dirty
+	 */
+	bool SyncAttributeBindings();
+
+	/** Stack and duration changes are only reported per effect */
+	void BindEffectEvents(UAbilitySystemComponent* InASC, FActiveGameplayEffectHandle Handle);
+	void HandleEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void HandleEffectRemoved(const FActiveGameplayEffect& Effect);
+	void HandleEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 NewStackCount, int32 PreviousStackCount);
+	void HandleEffectTimeChanged(FActiveGameplayEffectHandle Handle, float NewStartTime, float NewDuration);
+	void HandleTagCountChanged(const FGameplayTag Tag, int32 NewCount);
+	void HandleAttributeChanged(const FOnAttributeChangeData& Data);
+	void HandleAbilityChanged(UGameplayAbility* Ability);
+	void HandleAbilitySpecDirtied(const FGameplayAbilitySpec& Spec);
+
+	/** Seconds between periodic refreshes in Tick mode */
+	double GetRefreshInterval() const;
+
+	/** Rescan and notify all tabs once, measuring the cost */
+	void ExecuteRefresh();
+
+	/** A world was initialized or cleaned up, or PIE started or ended: the selected world may have changed */
+	void HandleWorldsChanged();
+
+	/** Recompile the actor tag query against the new tag net indices */
+	void HandleGameplayTagTreeChanged();
+
+	/** Drop the ASC selection when it does not belong to the selected world anymore */
+	void HandleSelectedWorldChanged();
+
+private:
+	TSharedRef<FGASWorldService> WorldService;
+	FDelegateHandle WorldsChangedHandle;
+	FDelegateHandle TagTreeChangedHandle;
+
 	FName SelectedWorldContextHandle;
+	mutable TWeakObjectPtr<UWorld> SelectedWorld;
+	mutable bool bSelectedWorldResolved = false;
+	bool bWorldChangePending = false;
 	TWeakObjectPtr<UAbilitySystemComponent> SelectedASC;
 	bool bPickingMode = true;
-	TArray<TWeakObjectPtr<UAbilitySystemComponent>> CachedASCList;
+	TSharedPtr<FGASASCRegistry> ASCRegistry;
+	TStrongObjectPtr<UGASDebugDataCollector> DataCollector;
+
+	// Actor tag query, the source query is kept to recompile it
+	FGameplayTagQuery ActorTagQuerySource;
+	FGASTagBitQuery ActorTagQuery;
+	bool bHasActorTagQuery = false;
+	FGASTagQueryIndex ActorTagIndex;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> FilteredASCList;
+	uint32 RecordedASCsVersion = 0;
+
+	// Dirty tracking
+	TWeakObjectPtr<UAbilitySystemComponent> DirtyTrackedASC;
+	FDelegateHandle EffectAddedHandle;
+	FDelegateHandle EffectRemovedHandle;
+	FDelegateHandle TagChangedHandle;
+	FDelegateHandle AbilityActivatedHandle;
+	FDelegateHandle AbilityEndedHandle;
+	FDelegateHandle AbilitySpecDirtiedHandle;
+	struct FEffectEventHandles
+	{
+		FDelegateHandle StackChanged;
+		FDelegateHandle TimeChanged;
+	};
+	TMap<FActiveGameplayEffectHandle, FEffectEventHandles> EffectEventHandles;
+	TArray<TPair<FGameplayAttribute, FDelegateHandle>> AttributeChangedHandles;
+	TArray<TObjectKey<UAttributeSet>> BoundAttributeSets;
+	uint8 DirtyCategories = GASDebugAllCategories;
+
+	// Ability state dependencies, bumped by the dirty tracking callbacks
+	uint32 OwnedTagsVersion = 0;
+	uint32 EffectsVersion = 0;
+	TMap<FGameplayAttribute, uint32> AttributeVersions;
+
+	// Scheduler state
+	bool bRefreshPending = false;
+	double LastRefreshTime = 0.0;
+	double LastAttributeSyncTime = 0.0;
+	uint64 LastRefreshFrame = 0;
+	double LastRefreshCostMs = 0.0;
+	double AverageRefreshCostMs = 0.0;
+
+	// Frame budget: each frame pays off one budget of the cost of earlier passes, no pass starts while in debt
+	double BudgetDebtMs = 0.0;
+	uint64 LastBudgetFrame = 0;
+	double PassStartTime = 0.0;
+	uint8 DeferredCategories = 0;
+	uint8 CarriedCategories = 0;
+
+	// Overhead display
+	FGASDebuggerOverhead Overhead;
+	uint64 RecorderCostFrame = 0;
+	uint64 PaintFrame = 0;
+	double PaintFrameSeconds = 0.0;
 };
@@ -0,0 +1,28 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASDebuggerStats.h"
+
+DEFINE_STAT(STAT_GASDebugger_RefreshPass);
+DEFINE_STAT(STAT_GASDebugger_RefreshASCList);
+DEFINE_STAT(STAT_GASDebugger_RefreshAbilities);
+DEFINE_STAT(STAT_GASDebugger_RefreshEffects);
+DEFINE_STAT(STAT_GASDebugger_RefreshTags);
+DEFINE_STAT(STAT_GASDebugger_RefreshAttributes);
+DEFINE_STAT(STAT_GASDebugger_BuildAttributeModel);
+DEFINE_STAT(STAT_GASDebugger_ApplyAttributeModel);
+DEFINE_STAT(STAT_GASDebugger_AbilityUpdateCache);
+DEFINE_STAT(STAT_GASDebugger_GenerateRow);
+
+DEFINE_STAT(STAT_GASDebugger_GetGrantedAbilities);
+DEFINE_STAT(STAT_GASDebugger_CaptureEffects);
+DEFINE_STAT(STAT_GASDebugger_CaptureTags);
+DEFINE_STAT(STAT_GASDebugger_DiffTags);
+DEFINE_STAT(STAT_GASDebugger_CaptureAttributes);
+DEFINE_STAT(STAT_GASDebugger_BuildModifierIndex);
+
+DEFINE_STAT(STAT_GASDebugger_RecordFrame);
+DEFINE_STAT(STAT_GASDebugger_RecorderMemory);
+
+DEFINE_STAT(STAT_GASDebugger_NodesBuilt);
+DEFINE_STAT(STAT_GASDebugger_WidgetsCreated);
+DEFINE_STAT(STAT_GASDebugger_BytesAllocated);
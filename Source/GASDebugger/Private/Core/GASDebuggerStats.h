@@ -0,0 +1,52 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Cost of the debugger itself, shown by "stat GASDebugger".
+ * Every cycle counter is paired with an Insights CPU event of the same name through GASDEBUGGER_SCOPE.
+ */
+DECLARE_STATS_GROUP(TEXT("GASDebugger"), STATGROUP_GASDebugger, STATCAT_Advanced);
+
+// Refresh paths
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Pass"), STAT_GASDebugger_RefreshPass, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh ASC List"), STAT_GASDebugger_RefreshASCList, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Abilities"), STAT_GASDebugger_RefreshAbilities, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Effects"), STAT_GASDebugger_RefreshEffects, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Tags"), STAT_GASDebugger_RefreshTags, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Attributes"), STAT_GASDebugger_RefreshAttributes, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Attribute Model"), STAT_GASDebugger_BuildAttributeModel, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Attribute Model"), STAT_GASDebugger_ApplyAttributeModel, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability UpdateCache"), STAT_GASDebugger_AbilityUpdateCache, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Row"), STAT_GASDebugger_GenerateRow, STATGROUP_GASDebugger, );
+
+// FGASDataProvider queries
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Granted Abilities"), STAT_GASDebugger_GetGrantedAbilities, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Effects"), STAT_GASDebugger_CaptureEffects, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Tags"), STAT_GASDebugger_CaptureTags, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Diff Tags"), STAT_GASDebugger_DiffTags, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Attributes"), STAT_GASDebugger_CaptureAttributes, STATGROUP_GASDebugger, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Modifier Index"), STAT_GASDebugger_BuildModifierIndex, STATGROUP_GASDebugger, );
+
+// Flight recorder
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Record Frame"), STAT_GASDebugger_RecordFrame, STATGROUP_GASDebugger, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Recorder Memory"), STAT_GASDebugger_RecorderMemory, STATGROUP_GASDebugger, );
+
+// Per frame counters, cleared every frame so they read as "per refresh" while one pass runs per frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Built"), STAT_GASDebugger_NodesBuilt, STATGROUP_GASDebugger, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets Created"), STAT_GASDebugger_WidgetsCreated, STATGROUP_GASDebugger, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Allocated"), STAT_GASDebugger_BytesAllocated, STATGROUP_GASDebugger, );
+
+/** Cycle counter plus Insights CPU event for the current scope */
+#define GASDEBUGGER_SCOPE(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+
+/** Count a tree node built by a refresh, with its size in the allocated bytes */
+#define GASDEBUGGER_COUNT_NODE(NodeType) \
+	INC_DWORD_STAT(STAT_GASDebugger_NodesBuilt); \
+	INC_DWORD_STAT_BY(STAT_GASDebugger_BytesAllocated, sizeof(NodeType))
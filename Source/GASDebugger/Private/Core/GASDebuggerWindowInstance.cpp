@@ -7,10 +7,10 @@
 
 #define LOCTEXT_NAMESPACE "GASDebuggerWindowInstance"
 
-FGASDebuggerWindowInstance::FGASDebuggerWindowInstance(int32 InInstanceId)
+FGASDebuggerWindowInstance::FGASDebuggerWindowInstance(int32 InInstanceId, TSharedRef<FGASWorldService> InWorldService)
 	: InstanceId(InInstanceId)
 {
-	SharedState = MakeShared<FGASDebuggerSharedState>();
+	SharedState = MakeShared<FGASDebuggerSharedState>(InWorldService);
 }
 
 FGASDebuggerWindowInstance::~FGASDebuggerWindowInstance()
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 class FGASDebuggerSharedState;
+class FGASWorldService;
 class FTabManager;
 class SDockTab;
 
@@ -15,7 +16,7 @@ class SDockTab;
 class FGASDebuggerWindowInstance : public TSharedFromThis<FGASDebuggerWindowInstance>
 {
 public:
-	FGASDebuggerWindowInstance(int32 InInstanceId);
+	FGASDebuggerWindowInstance(int32 InInstanceId, TSharedRef<FGASWorldService> InWorldService);
 	~FGASDebuggerWindowInstance();
 
 	// Getters
@@ -0,0 +1,790 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASFlightRecorder.h"
+#include "Core/GASASCRegistry.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASDebugDataCollector.h"
+#include "Core/GASDebuggerSharedState.h"
+#include "Core/GASDebuggerStats.h"
+#include "Core/GASWorldService.h"
+#include "GASDebuggerModule.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+
+namespace GASFlightRecorder
+{
+	/** Chunks are closed once they reach this size, eviction drops whole chunks */
+	static constexpr int32 ChunkSize = 256 * 1024;
+
+	static void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value) | 0x80);
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	/** Zigzag encoded, small negative deltas stay small */
+	static void WriteVarInt(TArray<uint8>& Out, int64 Value)
+	{
+		WriteVarUInt(Out, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	static void WriteEventType(TArray<uint8>& Out, EGASRecordedEventType Type)
+	{
+		Out.Add(static_cast<uint8>(Type));
+	}
+
+	struct FReader
+	{
+		const TArray<uint8>& Data;
+		int32 Offset = 0;
+
+		explicit FReader(const TArray<uint8>& InData) : Data(InData) {}
+
+		uint8 ReadByte()
+		{
+			return Data.IsValidIndex(Offset) ? Data[Offset++] : 0;
+		}
+
+		uint64 ReadVarUInt()
+		{
+			uint64 Value = 0;
+			for (int32 Shift = 0; Shift < 64 && Data.IsValidIndex(Offset); Shift += 7)
+			{
+				const uint8 Byte = Data[Offset++];
+				Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+				if ((Byte & 0x80) == 0)
+				{
+					break;
+				}
+			}
+			return Value;
+		}
+
+		int64 ReadVarInt()
+		{
+			const uint64 Value = ReadVarUInt();
+			return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+		}
+	};
+
+	/** Absolute state rebuilt while decoding one chunk of one ASC */
+	struct FDecodeState
+	{
+		TMap<uint32, int32> AbilityCounts;
+		TMap<int32, TPair<uint32, int32>> Effects;
+		TMap<uint32, int32> TagCounts;
+		TMap<uint32, TPair<uint32, uint32>> AttributeBits;
+	};
+
+	static const TCHAR* GetEventTypeName(EGASRecordedEventType Type)
+	{
+		switch (Type)
+		{
+		case EGASRecordedEventType::AbilityActivated:	return TEXT("AbilityActivated");
+		case EGASRecordedEventType::AbilityEnded:		return TEXT("AbilityEnded");
+		case EGASRecordedEventType::EffectApplied:		return TEXT("EffectApplied");
+		case EGASRecordedEventType::EffectRemoved:		return TEXT("EffectRemoved");
+		case EGASRecordedEventType::EffectStackChanged:	return TEXT("EffectStackChanged");
+		case EGASRecordedEventType::TagCountChanged:	return TEXT("TagCountChanged");
+		case EGASRecordedEventType::AttributeChanged:	return TEXT("AttributeChanged");
+		case EGASRecordedEventType::ASCRemoved:			return TEXT("ASCRemoved");
+		}
+		return TEXT("Unknown");
+	}
+}
+
+FGASFlightRecorder* FGASFlightRecorder::Instance = nullptr;
+
+void FGASFlightRecorder::Initialize()
+{
+	if (!Instance)
+	{
+		Instance = new FGASFlightRecorder();
+	}
+}
+
+void FGASFlightRecorder::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FGASFlightRecorder& FGASFlightRecorder::Get()
+{
+	check(Instance);
+	return *Instance;
+}
+
+FGASFlightRecorder::~FGASFlightRecorder()
+{
+	Stop();
+}
+
+void FGASFlightRecorder::FWatchedASC::ResetState()
+{
+	Abilities.Reset();
+	Effects.Reset();
+	TagCounts.Reset();
+	Attributes.Reset();
+}
+
+void FGASFlightRecorder::Start(UWorld* InWorld, TSharedRef<FGASASCRegistry> InRegistry)
+{
+	Clear();
+
+	RecordedWorld = InWorld;
+	Registry = InRegistry;
+	TargetsVersion = MAX_uint32;
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGASFlightRecorder::Tick));
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FGASFlightRecorder::HandleWorldCleanup);
+}
+
+void FGASFlightRecorder::Start(TSharedRef<FGASDebuggerSharedState> InSource)
+{
+	UWorld* World = InSource->GetSelectedWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	Start(World, InSource->GetWorldService().GetRegistry(World));
+	Source = InSource;
+	bFollowSource = true;
+}
+
+void FGASFlightRecorder::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	WorldCleanupHandle.Reset();
+
+	// The chunks stay readable, only the live encoding state goes
+	Registry.Reset();
+	Source.Reset();
+	bFollowSource = false;
+	bWatchedShrank = false;
+	Watched.Reset();
+	WatchedKeys.Reset();
+	TargetKeys.Reset();
+	TargetScratch.Reset();
+}
+
+void FGASFlightRecorder::Clear()
+{
+	Stop();
+
+	Chunks.Reset();
+	Names.Reset();
+	NameIds.Reset();
+	ASCNameIds.Reset();
+	NextEffectId = 0;
+	LastRecordedFrame = 0;
+	SET_MEMORY_STAT(STAT_GASDebugger_RecorderMemory, 0);
+}
+
+double FGASFlightRecorder::GetRecordedSeconds() const
+{
+	if (Chunks.Num() == 0)
+	{
+		return 0.0;
+	}
+	const FChunk& Last = *Chunks.Last();
+	return Last.FirstTime + Last.LastTimeUs / 1000000.0 - Chunks[0]->FirstTime;
+}
+
+SIZE_T FGASFlightRecorder::GetAllocatedSize() const
+{
+	SIZE_T Size = Chunks.GetAllocatedSize() + Names.GetAllocatedSize() + NameIds.GetAllocatedSize() + ASCNameIds.GetAllocatedSize()
+		+ Watched.GetAllocatedSize() + WatchedKeys.GetAllocatedSize() + TargetKeys.GetAllocatedSize() + TargetScratch.GetAllocatedSize();
+
+	for (const TUniquePtr<FChunk>& Chunk : Chunks)
+	{
+		Size += sizeof(FChunk) + Chunk->Data.GetAllocatedSize();
+	}
+	for (const FWatchedASC& Entry : Watched)
+	{
+		Size += Entry.Abilities.GetAllocatedSize() + Entry.Effects.GetAllocatedSize() + Entry.TagCounts.GetAllocatedSize() + Entry.Attributes.GetAllocatedSize()
+			+ Entry.EffectIds.GetAllocatedSize();
+	}
+	return Size;
+}
+
+bool FGASFlightRecorder::Tick(float DeltaTime)
+{
+	UWorld* World = RecordedWorld.Get();
+	if (!World || (bFollowSource && !Source.IsValid()))
+	{
+		Stop();
+		return false;
+	}
+
+	// The window switched worlds, none of its ASCs belong to the recorded one anymore.
+	// Stopping keeps the recording readable, recording again starts on the new world.
+	if (TSharedPtr<FGASDebuggerSharedState> PinnedSource = Source.Pin())
+	{
+		if (PinnedSource->GetSelectedWorld() != World)
+		{
+			Stop();
+			return false;
+		}
+	}
+
+	// The core ticker can run more than once per engine frame while the editor throttles
+	if (GFrameCounter != LastRecordedFrame)
+	{
+		LastRecordedFrame = GFrameCounter;
+		const double StartTime = FPlatformTime::Seconds();
+		UpdateWatched();
+		RecordFrame(GFrameCounter, World->GetTimeSeconds());
+		LastFrameCostMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+	return true;
+}
+
+void FGASFlightRecorder::UpdateWatched()
+{
+	// Debugger window: its selected ASC, or the actors matching its tag query
+	if (TSharedPtr<FGASDebuggerSharedState> PinnedSource = Source.Pin())
+	{
+		if (PinnedSource->GetRecordedASCsVersion() != TargetsVersion || bWatchedShrank)
+		{
+			TargetsVersion = PinnedSource->GetRecordedASCsVersion();
+			PinnedSource->GetRecordedASCs(TargetScratch);
+			ReconcileWatched(TargetScratch);
+		}
+		return;
+	}
+
+	// Console: every ASC of the world
+	if (Registry.IsValid() && (Registry->GetVersion() != TargetsVersion || bWatchedShrank))
+	{
+		TargetsVersion = Registry->GetVersion();
+		ReconcileWatched(Registry->GetComponents());
+	}
+}
+
+void FGASFlightRecorder::ReconcileWatched(const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Targets)
+{
+	bWatchedShrank = false;
+
+	const int32 MaxRecordedASCs = GetDefault<UGASDebugDataCollector>()->MaxRecordedASCs;
+	const UWorld* World = RecordedWorld.Get();
+
+	TargetKeys.Reset();
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : Targets)
+	{
+		if (TargetKeys.Num() >= MaxRecordedASCs)
+		{
+			break;
+		}
+		UAbilitySystemComponent* ASC = WeakASC.Get();
+		if (ASC && ASC->GetWorld() == World)
+		{
+			TargetKeys.Add(ASC);
+		}
+	}
+
+	// ASCs that left the set write their removal with the next frame
+	for (FWatchedASC& Entry : Watched)
+	{
+		if (!Entry.bDropped && !TargetKeys.Contains(Entry.Key))
+		{
+			Entry.bDropped = true;
+			WatchedKeys.Remove(Entry.Key);
+		}
+	}
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : Targets)
+	{
+		UAbilitySystemComponent* ASC = WeakASC.Get();
+		if (!ASC || !TargetKeys.Contains(ASC) || WatchedKeys.Contains(ASC))
+		{
+			continue;
+		}
+
+		// Ids are never reused, events of a destroyed ASC stay attributed to it
+		const AActor* Owner = ASC->GetOwner();
+		const FName OwnerName = Owner ? FName(*Owner->GetActorNameOrLabel()) : ASC->GetFName();
+
+		FWatchedASC& Entry = Watched.AddDefaulted_GetRef();
+		Entry.ASC = ASC;
+		Entry.Key = ASC;
+		Entry.ASCId = ASCNameIds.Add(InternName(OwnerName));
+		WatchedKeys.Add(ASC);
+	}
+}
+
+void FGASFlightRecorder::RecordFrame(uint64 Frame, double WorldTime)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RecordFrame);
+	using namespace GASFlightRecorder;
+
+	if (Chunks.Num() == 0 || Chunks.Last()->Data.Num() >= ChunkSize)
+	{
+		BeginChunk(Frame, WorldTime);
+	}
+
+	FChunk& Chunk = *Chunks.Last();
+	const bool bKeyframe = Chunk.NumFrames == 0;
+
+	FrameScratch.Reset();
+	int32 NumBlocks = 0;
+
+	for (int32 Index = 0; Index < Watched.Num();)
+	{
+		FWatchedASC& Entry = Watched[Index];
+		Scratch.Reset();
+
+		const bool bRemoved = Entry.bDropped || !Entry.ASC.IsValid();
+		int32 NumEvents = 0;
+		if (bRemoved)
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::ASCRemoved);
+			NumEvents = 1;
+		}
+		else
+		{
+			NumEvents = EncodeChanges(Entry, Frame, bKeyframe);
+		}
+
+		if (NumEvents > 0)
+		{
+			WriteVarUInt(FrameScratch, Entry.ASCId);
+			WriteVarUInt(FrameScratch, NumEvents);
+			FrameScratch.Append(Scratch);
+			++NumBlocks;
+		}
+
+		if (!bRemoved)
+		{
+			++Index;
+		}
+		else
+		{
+			// Dropped entries gave up their key already, the ASC may be watched again under a new id
+			if (!Entry.bDropped)
+			{
+				WatchedKeys.Remove(Entry.Key);
+			}
+			Watched.RemoveAtSwap(Index);
+			bWatchedShrank = true;
+		}
+	}
+
+	// Frames without changes are not written, the keyframe always is
+	if (NumBlocks == 0 && !bKeyframe)
+	{
+		return;
+	}
+
+	const uint64 TimeUs = static_cast<uint64>(FMath::Max(WorldTime - Chunk.FirstTime, 0.0) * 1000000.0);
+	WriteVarUInt(Chunk.Data, Frame - (bKeyframe ? Chunk.FirstFrame : Chunk.LastFrame));
+	WriteVarUInt(Chunk.Data, TimeUs - FMath::Min(TimeUs, Chunk.LastTimeUs));
+	WriteVarUInt(Chunk.Data, NumBlocks);
+	Chunk.Data.Append(FrameScratch);
+
+	Chunk.LastFrame = Frame;
+	Chunk.LastTimeUs = FMath::Max(TimeUs, Chunk.LastTimeUs);
+	++Chunk.NumFrames;
+}
+
+int32 FGASFlightRecorder::EncodeChanges(FWatchedASC& Entry, uint64 Frame, bool bKeyframe)
+{
+	using namespace GASFlightRecorder;
+
+	UAbilitySystemComponent* ASC = Entry.ASC.Get();
+	int32 NumEvents = 0;
+
+	// Abilities, the change of each spec's active count
+	for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+	{
+		FAbilityState& State = Entry.Abilities.FindOrAdd(Spec.Handle);
+		if (State.SeenFrame == 0)
+		{
+			State.NameId = InternName(Spec.Ability ? Spec.Ability->GetClass()->GetFName() : NAME_None);
+		}
+		State.SeenFrame = Frame;
+
+		const int32 Delta = Spec.ActiveCount - State.ActiveCount;
+		if (Delta != 0)
+		{
+			WriteEventType(Scratch, Delta > 0 ? EGASRecordedEventType::AbilityActivated : EGASRecordedEventType::AbilityEnded);
+			WriteVarUInt(Scratch, State.NameId);
+			WriteVarUInt(Scratch, FMath::Abs(Delta));
+			State.ActiveCount = Spec.ActiveCount;
+			++NumEvents;
+		}
+	}
+	for (auto It = Entry.Abilities.CreateIterator(); It; ++It)
+	{
+		if (It.Value().SeenFrame != Frame)
+		{
+			// Cleared while active
+			if (It.Value().ActiveCount > 0)
+			{
+				WriteEventType(Scratch, EGASRecordedEventType::AbilityEnded);
+				WriteVarUInt(Scratch, It.Value().NameId);
+				WriteVarUInt(Scratch, It.Value().ActiveCount);
+				++NumEvents;
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	// Effects, applies carry the definition name once, later events only the effect id
+	for (const FActiveGameplayEffect& Effect : &ASC->GetActiveGameplayEffects())
+	{
+		const int32 StackCount = Effect.Spec.GetStackCount();
+		FEffectState* State = Entry.Effects.Find(Effect.Handle);
+		if (!State)
+		{
+			// A keyframe restates effects that are already live under their existing id
+			int32& EffectId = Entry.EffectIds.FindOrAdd(Effect.Handle, INDEX_NONE);
+			if (EffectId == INDEX_NONE)
+			{
+				EffectId = NextEffectId++;
+			}
+
+			State = &Entry.Effects.Add(Effect.Handle);
+			State->EffectId = EffectId;
+			State->StackCount = StackCount;
+
+			WriteEventType(Scratch, EGASRecordedEventType::EffectApplied);
+			WriteVarUInt(Scratch, State->EffectId);
+			WriteVarUInt(Scratch, InternName(Effect.Spec.Def ? Effect.Spec.Def->GetClass()->GetFName() : NAME_None));
+			WriteVarUInt(Scratch, StackCount);
+			++NumEvents;
+		}
+		else if (State->StackCount != StackCount)
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::EffectStackChanged);
+			WriteVarUInt(Scratch, State->EffectId);
+			WriteVarInt(Scratch, StackCount - State->StackCount);
+			State->StackCount = StackCount;
+			++NumEvents;
+		}
+		State->SeenFrame = Frame;
+	}
+	for (auto It = Entry.Effects.CreateIterator(); It; ++It)
+	{
+		if (It.Value().SeenFrame != Frame)
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::EffectRemoved);
+			WriteVarUInt(Scratch, It.Value().EffectId);
+			++NumEvents;
+			Entry.EffectIds.Remove(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+
+	// Tags, count deltas of the explicitly owned tags
+	TagScratch.Reset();
+	ASC->GetOwnedGameplayTags(TagScratch);
+	for (const FGameplayTag& Tag : TagScratch)
+	{
+		const int32 Count = ASC->GetTagCount(Tag);
+		int32& WrittenCount = Entry.TagCounts.FindOrAdd(Tag);
+		if (Count != WrittenCount)
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::TagCountChanged);
+			WriteVarUInt(Scratch, InternName(Tag.GetTagName()));
+			WriteVarInt(Scratch, Count - WrittenCount);
+			WrittenCount = Count;
+			++NumEvents;
+		}
+	}
+	for (auto It = Entry.TagCounts.CreateIterator(); It; ++It)
+	{
+		if (!TagScratch.HasTagExact(It.Key()))
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::TagCountChanged);
+			WriteVarUInt(Scratch, InternName(It.Key().GetTagName()));
+			WriteVarInt(Scratch, -It.Value());
+			++NumEvents;
+			It.RemoveCurrent();
+		}
+	}
+
+	// Attributes, the difference of the float bits keeps small changes in few bytes.
+	// A keyframe writes every attribute, values that are still 0 would otherwise be missing from it
+	FGASDataProvider::CaptureAttributes(ASC, AttributeScratch);
+	for (const FGASAttributeInfo& Info : AttributeScratch)
+	{
+		FAttributeState* State = Entry.Attributes.Find(Info.Attribute);
+		if (!State)
+		{
+			State = &Entry.Attributes.Add(Info.Attribute);
+			State->NameId = InternName(FName(*FString::Printf(TEXT("%s.%s"), *Info.AttributeSetName.ToString(), *Info.AttributeName.ToString())));
+		}
+
+		const uint32 BaseBits = FMath::AsUInt(Info.BaseValue);
+		const uint32 CurrentBits = FMath::AsUInt(Info.CurrentValue);
+		if (bKeyframe || BaseBits != State->BaseBits || CurrentBits != State->CurrentBits)
+		{
+			WriteEventType(Scratch, EGASRecordedEventType::AttributeChanged);
+			WriteVarUInt(Scratch, State->NameId);
+			WriteVarInt(Scratch, static_cast<int64>(BaseBits) - static_cast<int64>(State->BaseBits));
+			WriteVarInt(Scratch, static_cast<int64>(CurrentBits) - static_cast<int64>(State->CurrentBits));
+			State->BaseBits = BaseBits;
+			State->CurrentBits = CurrentBits;
+			++NumEvents;
+		}
+	}
+
+	return NumEvents;
+}
+
+void FGASFlightRecorder::BeginChunk(uint64 Frame, double WorldTime)
+{
+	if (Chunks.Num() > 0)
+	{
+		Chunks.Last()->Data.Shrink();
+	}
+
+	// Evict before allocating, the new chunk reserves its full size
+	const SIZE_T MemoryCap = static_cast<SIZE_T>(FMath::Max(GetDefault<UGASDebugDataCollector>()->RecorderMemoryCapMB, 1)) * 1024 * 1024;
+	while (Chunks.Num() > 0 && GetAllocatedSize() + GASFlightRecorder::ChunkSize > MemoryCap)
+	{
+		Chunks.RemoveAt(0);
+	}
+
+	TUniquePtr<FChunk>& Chunk = Chunks.Add_GetRef(MakeUnique<FChunk>());
+	Chunk->FirstFrame = Frame;
+	Chunk->LastFrame = Frame;
+	Chunk->FirstTime = WorldTime;
+	Chunk->Data.Reserve(GASFlightRecorder::ChunkSize);
+
+	// The chunk must decode without its predecessors, its first frame restates everything
+	for (FWatchedASC& Entry : Watched)
+	{
+		Entry.ResetState();
+	}
+
+	SET_MEMORY_STAT(STAT_GASDebugger_RecorderMemory, GetAllocatedSize());
+}
+
+uint32 FGASFlightRecorder::InternName(FName Name)
+{
+	if (const uint32* Id = NameIds.Find(Name))
+	{
+		return *Id;
+	}
+	const uint32 Id = Names.Add(Name);
+	NameIds.Add(Name, Id);
+	return Id;
+}
+
+void FGASFlightRecorder::ForEachEvent(TFunctionRef<void(const FGASRecordedEvent&)> Visitor) const
+{
+	using namespace GASFlightRecorder;
+
+	auto GetName = [this](uint64 Id)
+	{
+		return Names.IsValidIndex(static_cast<int32>(Id)) ? Names[static_cast<int32>(Id)] : NAME_None;
+	};
+
+	for (const TUniquePtr<FChunk>& Chunk : Chunks)
+	{
+		// Every chunk starts from empty state, its keyframe fills it
+		TMap<int32, FDecodeState> States;
+		FReader Reader(Chunk->Data);
+
+		uint64 Frame = Chunk->FirstFrame;
+		uint64 TimeUs = 0;
+
+		for (int32 FrameIndex = 0; FrameIndex < Chunk->NumFrames; ++FrameIndex)
+		{
+			FGASRecordedEvent Event;
+			Frame += Reader.ReadVarUInt();
+			TimeUs += Reader.ReadVarUInt();
+			Event.Frame = Frame;
+			Event.WorldTime = Chunk->FirstTime + TimeUs / 1000000.0;
+			Event.bKeyframe = FrameIndex == 0;
+
+			const uint64 NumBlocks = Reader.ReadVarUInt();
+			for (uint64 Block = 0; Block < NumBlocks; ++Block)
+			{
+				Event.ASCId = static_cast<int32>(Reader.ReadVarUInt());
+				Event.ASCName = ASCNameIds.IsValidIndex(Event.ASCId) ? GetName(ASCNameIds[Event.ASCId]) : NAME_None;
+				FDecodeState& State = States.FindOrAdd(Event.ASCId);
+
+				const uint64 NumEvents = Reader.ReadVarUInt();
+				for (uint64 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
+				{
+					Event.Type = static_cast<EGASRecordedEventType>(Reader.ReadByte());
+					Event.Name = NAME_None;
+					Event.EffectId = INDEX_NONE;
+					Event.Count = 0;
+					Event.BaseValue = 0.0f;
+					Event.CurrentValue = 0.0f;
+
+					switch (Event.Type)
+					{
+					case EGASRecordedEventType::AbilityActivated:
+					case EGASRecordedEventType::AbilityEnded:
+					{
+						const uint32 NameId = static_cast<uint32>(Reader.ReadVarUInt());
+						const int32 Delta = static_cast<int32>(Reader.ReadVarUInt());
+						int32& Count = State.AbilityCounts.FindOrAdd(NameId);
+						Count += (Event.Type == EGASRecordedEventType::AbilityActivated) ? Delta : -Delta;
+						Event.Name = GetName(NameId);
+						Event.Count = Count;
+						break;
+					}
+					case EGASRecordedEventType::EffectApplied:
+					{
+						Event.EffectId = static_cast<int32>(Reader.ReadVarUInt());
+						const uint32 NameId = static_cast<uint32>(Reader.ReadVarUInt());
+						Event.Count = static_cast<int32>(Reader.ReadVarUInt());
+						State.Effects.Add(Event.EffectId, TPair<uint32, int32>(NameId, Event.Count));
+						Event.Name = GetName(NameId);
+						break;
+					}
+					case EGASRecordedEventType::EffectRemoved:
+					{
+						Event.EffectId = static_cast<int32>(Reader.ReadVarUInt());
+						TPair<uint32, int32> Effect;
+						if (State.Effects.RemoveAndCopyValue(Event.EffectId, Effect))
+						{
+							Event.Name = GetName(Effect.Key);
+						}
+						break;
+					}
+					case EGASRecordedEventType::EffectStackChanged:
+					{
+						Event.EffectId = static_cast<int32>(Reader.ReadVarUInt());
+						const int32 Delta = static_cast<int32>(Reader.ReadVarInt());
+						TPair<uint32, int32>& Effect = State.Effects.FindOrAdd(Event.EffectId);
+						Effect.Value += Delta;
+						Event.Name = GetName(Effect.Key);
+						Event.Count = Effect.Value;
+						break;
+					}
+					case EGASRecordedEventType::TagCountChanged:
+					{
+						const uint32 NameId = static_cast<uint32>(Reader.ReadVarUInt());
+						int32& Count = State.TagCounts.FindOrAdd(NameId);
+						Count += static_cast<int32>(Reader.ReadVarInt());
+						Event.Name = GetName(NameId);
+						Event.Count = Count;
+						break;
+					}
+					case EGASRecordedEventType::AttributeChanged:
+					{
+						const uint32 NameId = static_cast<uint32>(Reader.ReadVarUInt());
+						TPair<uint32, uint32>& Bits = State.AttributeBits.FindOrAdd(NameId);
+						Bits.Key = static_cast<uint32>(static_cast<int64>(Bits.Key) + Reader.ReadVarInt());
+						Bits.Value = static_cast<uint32>(static_cast<int64>(Bits.Value) + Reader.ReadVarInt());
+						Event.Name = GetName(NameId);
+						Event.BaseValue = FMath::AsFloat(Bits.Key);
+						Event.CurrentValue = FMath::AsFloat(Bits.Value);
+						break;
+					}
+					case EGASRecordedEventType::ASCRemoved:
+						States.Remove(Event.ASCId);
+						break;
+					}
+
+					Visitor(Event);
+				}
+			}
+		}
+	}
+}
+
+void FGASFlightRecorder::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// Keep what was recorded, it is most useful right after the session ended
+	if (World == RecordedWorld.Get())
+	{
+		Stop();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// GASDebugger.Recorder.*
+
+namespace GASFlightRecorder
+{
+	static void RunStartCommand(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		FGASWorldService& WorldService = FGASDebuggerModule::Get().GetWorldService();
+
+		// The console's world, or the first PIE/Game world when the command runs from the editor
+		UWorld* World = (InWorld && InWorld->IsGameWorld()) ? InWorld : nullptr;
+		if (!World && WorldService.GetWorldContexts().Num() > 0)
+		{
+			World = WorldService.GetWorldContexts()[0].World.Get();
+		}
+		if (!World)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger recorder: needs a PIE or game world"));
+			return;
+		}
+
+		FGASFlightRecorder::Get().Start(World, WorldService.GetRegistry(World));
+		Ar.Logf(TEXT("GASDebugger recorder: recording %s, up to %d ASCs and %d MB"), *World->GetName(),
+			GetDefault<UGASDebugDataCollector>()->MaxRecordedASCs, GetDefault<UGASDebugDataCollector>()->RecorderMemoryCapMB);
+	}
+
+	static void RunStopCommand(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		FGASFlightRecorder& Recorder = FGASFlightRecorder::Get();
+		Recorder.Stop();
+		Ar.Logf(TEXT("GASDebugger recorder: stopped, %.1f s held in %.2f MB"), Recorder.GetRecordedSeconds(), Recorder.GetAllocatedSize() / (1024.0 * 1024.0));
+	}
+
+	static void RunDumpCommand(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		const FString Path = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("GASDebugger") / TEXT("Recording.csv");
+
+		FString Csv = TEXT("Frame,Time,Keyframe,ASC,Event,Name,EffectId,Count,BaseValue,CurrentValue\n");
+		int32 NumEvents = 0;
+		FGASFlightRecorder::Get().ForEachEvent([&Csv, &NumEvents](const FGASRecordedEvent& Event)
+		{
+			Csv += FString::Printf(TEXT("%llu,%.6f,%d,%s,%s,%s,%d,%d,%g,%g\n"), Event.Frame, Event.WorldTime, Event.bKeyframe ? 1 : 0,
+				*Event.ASCName.ToString(), GetEventTypeName(Event.Type), *Event.Name.ToString(), Event.EffectId, Event.Count, Event.BaseValue, Event.CurrentValue);
+			++NumEvents;
+		});
+
+		if (FFileHelper::SaveStringToFile(Csv, *Path))
+		{
+			Ar.Logf(TEXT("GASDebugger recorder: %d events written to %s"), NumEvents, *Path);
+		}
+		else
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger recorder: could not write %s"), *Path);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice StartCommand(
+		TEXT("GASDebugger.Recorder.Start"),
+		TEXT("Record the GAS state changes of every ASC of the world each frame, dropping the previous recording. The Record box of a debugger window records its selected or filtered ASCs instead"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunStartCommand));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice StopCommand(
+		TEXT("GASDebugger.Recorder.Stop"),
+		TEXT("Stop recording, the recording is kept for GASDebugger.Recorder.Dump"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunStopCommand));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("GASDebugger.Recorder.Dump"),
+		TEXT("Write the recorded events as CSV. Usage: GASDebugger.Recorder.Dump [Path=Saved/GASDebugger/Recording.csv]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunDumpCommand));
+}
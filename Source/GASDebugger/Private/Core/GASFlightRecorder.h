@@ -0,0 +1,245 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Containers/Ticker.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "GameplayTagContainer.h"
+#include "AttributeSet.h"
+#include "GASDebuggerTypes.h"
+
+class FGASASCRegistry;
+class FGASDebuggerSharedState;
+class UAbilitySystemComponent;
+class UWorld;
+
+/** Kind of a recorded change */
+enum class EGASRecordedEventType : uint8
+{
+	AbilityActivated,
+	AbilityEnded,
+	EffectApplied,
+	EffectRemoved,
+	EffectStackChanged,
+	TagCountChanged,
+	AttributeChanged,
+
+	/** The ASC was destroyed or left the recorded set, its state is gone */
+	ASCRemoved,
+};
+
+/** One decoded change, values are absolute */
+struct FGASRecordedEvent
+{
+	uint64 Frame = 0;
+	double WorldTime = 0.0;
+
+	/** Part of a chunk's opening frame, which restates the full state of every ASC instead of changes */
+	bool bKeyframe = false;
+
+	int32 ASCId = INDEX_NONE;
+	FName ASCName;
+
+	EGASRecordedEventType Type = EGASRecordedEventType::AbilityActivated;
+
+	/** Ability class, effect definition, tag or "Set.Attribute" name */
+	FName Name;
+
+	/** Identifies an effect instance from its apply to its removal */
+	int32 EffectId = INDEX_NONE;
+
+	/** Activations of the ability, stacks of the effect or count of the tag after the change */
+	int32 Count = 0;
+
+	float BaseValue = 0.0f;
+	float CurrentValue = 0.0f;
+};
+
+/**
+ * Flight recorder for the GAS state of a world's ASCs, so a problem can be inspected after it happened.
+ * Started from a debugger window it records the ASCs that window shows: the selected one, or every actor
+ * matching the tag query. Recording is opt-in, it costs a full state compare per watched ASC and frame.
+ * While recording, every frame each watched ASC is compared with the previous frame and only the changes
+ * are written: ability activations and ends, effect applies, removes and stack changes, tag count deltas
+ * and attribute value deltas. Changes go into fixed-size chunks of variable-length integers, names
+ * are interned once in a table and referenced by index, and attribute values are stored as the difference
+ * of their bits to the previous value. Each chunk opens with a keyframe of the full state, so the oldest
+ * chunks can be evicted once the memory cap (RecorderMemoryCapMB) is reached.
+ */
+class FGASFlightRecorder
+{
+public:
+	/** Create the recorder, called on module startup */
+	static void Initialize();
+
+	/** Destroy the recorder, called on module shutdown */
+	static void Shutdown();
+
+	static FGASFlightRecorder& Get();
+
+	/**
+	 * Start recording every ASC of a world, dropping the previous recording
+	 * @param InWorld World whose ASCs are recorded, recording stops when it is cleaned up
+	 * @param InRegistry ASC registry of the world, ASCs registered while recording are watched too
+	 */
+	void Start(UWorld* InWorld, TSharedRef<FGASASCRegistry> InRegistry);
+
+	/**
+	 * Start recording the ASCs a debugger window shows, dropping the previous recording
+	 * @param InSource Shared state of the window, the watched ASCs follow its selection and tag query,
+	 *                 recording stops with the window or when it selects another world
+	 */
+	void Start(TSharedRef<FGASDebuggerSharedState> InSource);
+
+	/** Stop recording, the recording stays available until the next Start or Clear */
+	void Stop();
+
+	bool IsRecording() const { return TickerHandle.IsValid(); }
+
+	/** True while recording the ASCs of this debugger window */
+	bool IsRecordingFrom(const FGASDebuggerSharedState& InSource) const { return IsRecording() && Source.HasSameObject(&InSource); }
+	UWorld* GetRecordedWorld() const { return RecordedWorld.Get(); }
+
+	/** Stop recording and drop the recording */
+	void Clear();
+
+	/** Cost of the last recorded frame in ms, and that frame's number */
+	double GetLastFrameCostMs() const { return LastFrameCostMs; }
+	uint64 GetLastRecordedFrame() const { return LastRecordedFrame; }
+
+	/** Number of ASCs watched by the running recording */
+	int32 GetNumWatched() const { return Watched.Num(); }
+
+	/** Time span of the frames still held */
+	double GetRecordedSeconds() const;
+
+	/** Memory held by the chunks, the name table and the per-ASC encoding state */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Decode every event still held, oldest first */
+	void ForEachEvent(TFunctionRef<void(const FGASRecordedEvent&)> Visitor) const;
+
+private:
+	FGASFlightRecorder() {}
+	~FGASFlightRecorder();
+
+	/** Run of recorded frames, the first one is a keyframe */
+	struct FChunk
+	{
+		uint64 FirstFrame = 0;
+		uint64 LastFrame = 0;
+		double FirstTime = 0.0;
+
+		/** World time of the last frame in microseconds after FirstTime, frames store the difference to it */
+		uint64 LastTimeUs = 0;
+
+		int32 NumFrames = 0;
+		TArray<uint8> Data;
+	};
+
+	struct FAbilityState
+	{
+		uint32 NameId = 0;
+		int32 ActiveCount = 0;
+		uint64 SeenFrame = 0;
+	};
+
+	struct FEffectState
+	{
+		int32 EffectId = INDEX_NONE;
+		int32 StackCount = 0;
+		uint64 SeenFrame = 0;
+	};
+
+	struct FAttributeState
+	{
+		uint32 NameId = 0;
+		uint32 BaseBits = 0;
+		uint32 CurrentBits = 0;
+	};
+
+	/** What the encoder last wrote for an ASC, changes are computed against it */
+	struct FWatchedASC
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> ASC;
+		TObjectKey<UAbilitySystemComponent> Key;
+		int32 ASCId = INDEX_NONE;
+
+		/** Left the recorded set, the next frame writes its removal */
+		bool bDropped = false;
+
+		TMap<FGameplayAbilitySpecHandle, FAbilityState> Abilities;
+		TMap<FActiveGameplayEffectHandle, FEffectState> Effects;
+		TMap<FGameplayTag, int32> TagCounts;
+		TMap<FGameplayAttribute, FAttributeState> Attributes;
+
+		/** Recorded id of each live effect, kept across chunks so a keyframe restates the same id */
+		TMap<FActiveGameplayEffectHandle, int32> EffectIds;
+
+		/** Forget the written state, the next frame restates everything */
+		void ResetState();
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Follow the recorded set when it changed or a watched ASC went away, up to MaxRecordedASCs */
+	void UpdateWatched();
+
+	/** Watch exactly the first MaxRecordedASCs valid ASCs of the world in Targets */
+	void ReconcileWatched(const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Targets);
+
+	/** Write the changes of one frame, the first frame of a chunk writes the full state */
+	void RecordFrame(uint64 Frame, double WorldTime);
+
+	/** Append one ASC's changes to Scratch, or its full state for a keyframe, returns the number of events written */
+	int32 EncodeChanges(FWatchedASC& Entry, uint64 Frame, bool bKeyframe);
+
+	/** Close the current chunk and open a new one, evicting the oldest chunks over the memory cap */
+	void BeginChunk(uint64 Frame, double WorldTime);
+
+	uint32 InternName(FName Name);
+
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+private:
+	static FGASFlightRecorder* Instance;
+
+	TWeakObjectPtr<UWorld> RecordedWorld;
+	TSharedPtr<FGASASCRegistry> Registry;
+	TWeakPtr<FGASDebuggerSharedState> Source;
+	bool bFollowSource = false;
+
+	/** Version of the registry or source the watched set was built from */
+	uint32 TargetsVersion = 0;
+
+	/** A watched ASC went away, a skipped one may take its slot */
+	bool bWatchedShrank = false;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle WorldCleanupHandle;
+
+	TArray<FWatchedASC> Watched;
+	TSet<TObjectKey<UAbilitySystemComponent>> WatchedKeys;
+	TSet<TObjectKey<UAbilitySystemComponent>> TargetKeys;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> TargetScratch;
+
+	/** Interned names, referenced by index from the chunks and ASCNameIds */
+	TArray<FName> Names;
+	TMap<FName, uint32> NameIds;
+
+	/** Owner name of each recorded ASC, indexed by ASC id */
+	TArray<uint32> ASCNameIds;
+
+	TArray<TUniquePtr<FChunk>> Chunks;
+	int32 NextEffectId = 0;
+
+	/** Events of the ASC being encoded, and of the frame being encoded */
+	TArray<uint8> Scratch;
+	TArray<uint8> FrameScratch;
+	FGameplayTagContainer TagScratch;
+	TArray<FGASAttributeInfo> AttributeScratch;
+	uint64 LastRecordedFrame = 0;
+	double LastFrameCostMs = 0.0;
+};
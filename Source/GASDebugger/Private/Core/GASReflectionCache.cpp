@@ -0,0 +1,311 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASReflectionCache.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayTask.h"
+#include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
+#include "GameplayTagsModule.h"
+#include "AttributeSet.h"
+#include "GameplayEffect.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+
+FGASReflectionCache* FGASReflectionCache::Instance = nullptr;
+
+namespace GASReflectionCache
+{
+	/** Property names of the tag containers, indexed by EGASAbilityTagProperty */
+	static const TCHAR* TagPropertyNames[] =
+	{
+		TEXT("ActivationOwnedTags"),
+		TEXT("ActivationRequiredTags"),
+		TEXT("ActivationBlockedTags"),
+		TEXT("SourceRequiredTags"),
+		TEXT("SourceBlockedTags"),
+		TEXT("TargetRequiredTags"),
+		TEXT("TargetBlockedTags"),
+		TEXT("CancelAbilitiesWithTag"),
+	};
+	static_assert(UE_ARRAY_COUNT(TagPropertyNames) == static_cast<int32>(EGASAbilityTagProperty::Num), "Missing tag property name");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FGASAbilityClassInfo
+
+const TArray<FAbilityTriggerData>* FGASAbilityClassInfo::GetAbilityTriggers(const UGameplayAbility* Ability) const
+{
+	return (AbilityTriggers && Ability) ? AbilityTriggers->ContainerPtrToValuePtr<TArray<FAbilityTriggerData>>(Ability) : nullptr;
+}
+
+const TArray<UGameplayTask*>* FGASAbilityClassInfo::GetActiveTasks(const UGameplayAbility* Ability) const
+{
+	return (ActiveTasks && Ability) ? ActiveTasks->ContainerPtrToValuePtr<TArray<UGameplayTask*>>(Ability) : nullptr;
+}
+
+const FGameplayTagContainer* FGASAbilityClassInfo::GetTags(const UGameplayAbility* Ability, EGASAbilityTagProperty Tags) const
+{
+	const FStructProperty* Property = TagProperties[static_cast<int32>(Tags)];
+	return (Property && Ability) ? Property->ContainerPtrToValuePtr<FGameplayTagContainer>(Ability) : nullptr;
+}
+
+bool FGASAbilityClassInfo::ActivatesOnGranted(const UGameplayAbility* Ability) const
+{
+	return ActivateAbilityOnGranted && Ability && ActivateAbilityOnGranted->GetPropertyValue_InContainer(Ability);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FGASReflectionCache
+
+void FGASReflectionCache::Initialize()
+{
+	if (!Instance)
+	{
+		Instance = new FGASReflectionCache();
+	}
+}
+
+void FGASReflectionCache::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FGASReflectionCache& FGASReflectionCache::Get()
+{
+	check(Instance);
+	return *Instance;
+}
+
+FGASReflectionCache::FGASReflectionCache()
+{
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(this, &FGASReflectionCache::HandleObjectsReplaced);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FGASReflectionCache::HandleReloadComplete);
+	TagTreeChangedHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddRaw(this, &FGASReflectionCache::HandleGameplayTagTreeChanged);
+}
+
+FGASReflectionCache::~FGASReflectionCache()
+{
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(TagTreeChangedHandle);
+}
+
+const FGASAbilityClassInfo& FGASReflectionCache::GetAbilityClassInfo(const UClass* AbilityClass)
+{
+	const TObjectKey<UClass> Key(AbilityClass);
+	if (const FGASAbilityClassInfo* Info = AbilityClasses.Find(Key))
+	{
+		return *Info;
+	}
+
+	return AbilityClasses.Add(Key, BuildAbilityClassInfo(AbilityClass));
+}
+
+const FGASAttributeSetLayout& FGASReflectionCache::GetAttributeSetLayout(const UClass* AttributeSetClass)
+{
+	const TObjectKey<UClass> Key(AttributeSetClass);
+	if (const FGASAttributeSetLayout* Layout = AttributeSetLayouts.Find(Key))
+	{
+		return *Layout;
+	}
+
+	return AttributeSetLayouts.Add(Key, BuildAttributeSetLayout(AttributeSetClass));
+}
+
+const FGASEffectDefinitionInfo& FGASReflectionCache::GetEffectDefinitionInfo(const UGameplayEffect* Definition)
+{
+	const TObjectKey<UGameplayEffect> Key(Definition);
+	FGASEffectDefinitionInfo* Info = EffectDefinitions.Find(Key);
+
+	// Runtime-built definitions and defaults edited in PIE can gain or lose modifiers without being reinstanced
+	if (Info && (!Definition || Info->ModifierAttributeNames.Num() == Definition->Modifiers.Num()))
+	{
+		return *Info;
+	}
+
+	return EffectDefinitions.Add(Key, BuildEffectDefinitionInfo(Definition));
+}
+
+const TArray<uint16>& FGASReflectionCache::GetTagLexicalRanks(uint16 MaxNetIndex)
+{
+	EnsureTagTables(MaxNetIndex);
+	return TagLexicalRanks;
+}
+
+const TArray<uint16>& FGASReflectionCache::GetTagParentNetIndices(uint16 MaxNetIndex)
+{
+	EnsureTagTables(MaxNetIndex);
+	return TagParentNetIndices;
+}
+
+void FGASReflectionCache::Reset()
+{
+	AbilityClasses.Reset();
+	AttributeSetLayouts.Reset();
+	EffectDefinitions.Reset();
+}
+
+FGASAbilityClassInfo FGASReflectionCache::BuildAbilityClassInfo(const UClass* AbilityClass) const
+{
+	FGASAbilityClassInfo Info;
+	if (!AbilityClass)
+	{
+		return Info;
+	}
+
+	Info.AbilityTriggers = FindFProperty<FArrayProperty>(AbilityClass, TEXT("AbilityTriggers"));
+	Info.ActiveTasks = FindFProperty<FArrayProperty>(AbilityClass, TEXT("ActiveTasks"));
+
+	// May not exist depending on the engine version
+	Info.ActivateAbilityOnGranted = FindFProperty<FBoolProperty>(AbilityClass, TEXT("bActivateAbilityOnGranted"));
+
+	for (int32 Index = 0; Index < static_cast<int32>(EGASAbilityTagProperty::Num); ++Index)
+	{
+		const FStructProperty* Property = FindFProperty<FStructProperty>(AbilityClass, GASReflectionCache::TagPropertyNames[Index]);
+		if (Property && Property->Struct == FGameplayTagContainer::StaticStruct())
+		{
+			Info.TagProperties[Index] = Property;
+		}
+	}
+
+	return Info;
+}
+
+FGASAttributeSetLayout FGASReflectionCache::BuildAttributeSetLayout(const UClass* AttributeSetClass) const
+{
+	FGASAttributeSetLayout Layout;
+	if (!AttributeSetClass)
+	{
+		return Layout;
+	}
+
+	Layout.SetName = AttributeSetClass->GetFName();
+
+	for (TFieldIterator<FStructProperty> It(AttributeSetClass); It; ++It)
+	{
+		FStructProperty* Property = *It;
+		if (Property->Struct != FGameplayAttributeData::StaticStruct())
+		{
+			continue;
+		}
+
+		FGASAttributeLayoutEntry& Entry = Layout.Attributes.AddDefaulted_GetRef();
+		Entry.Attribute = FGameplayAttribute(Property);
+		Entry.Name = Property->GetFName();
+		Entry.Offset = Property->GetOffset_ForInternal();
+	}
+
+	return Layout;
+}
+
+FGASEffectDefinitionInfo FGASReflectionCache::BuildEffectDefinitionInfo(const UGameplayEffect* Definition) const
+{
+	FGASEffectDefinitionInfo Info;
+	if (!Definition)
+	{
+		return Info;
+	}
+
+	FString ClassName = Definition->GetClass()->GetName();
+	if (ClassName.EndsWith(TEXT("_C")))
+	{
+		ClassName.LeftChopInline(2);
+	}
+	Info.DisplayName = *ClassName;
+
+	Info.ModifierAttributeNames.Reserve(Definition->Modifiers.Num());
+	for (const FGameplayModifierInfo& Modifier : Definition->Modifiers)
+	{
+		Info.ModifierAttributeNames.Add(*Modifier.Attribute.GetName());
+	}
+
+	return Info;
+}
+
+void FGASReflectionCache::EnsureTagTables(uint16 MaxNetIndex)
+{
+	if (MaxNetIndex < TagLexicalRanks.Num())
+	{
+		return;
+	}
+
+	BuildTagTables();
+
+	// Indices the manager does not know sort last, and stop triggering rebuilds
+	while (MaxNetIndex >= TagLexicalRanks.Num())
+	{
+		TagLexicalRanks.Add(MAX_uint16);
+		TagParentNetIndices.Add(MAX_uint16);
+	}
+}
+
+void FGASReflectionCache::BuildTagTables()
+{
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const FGameplayTagNetIndex InvalidNetIndex = TagsManager.GetInvalidTagNetIndex();
+
+	FGameplayTagContainer AllTags;
+	TagsManager.RequestAllGameplayTags(AllTags, false);
+
+	// Sorting once here is what lets snapshots sort by integer compares
+	TArray<FGameplayTag> SortedTags;
+	AllTags.GetGameplayTagArray(SortedTags);
+	SortedTags.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return A.GetTagName().Compare(B.GetTagName()) < 0;
+	});
+
+	TArray<FGameplayTagNetIndex> NetIndices;
+	NetIndices.Reserve(SortedTags.Num());
+	int32 MaxNetIndex = INDEX_NONE;
+	for (const FGameplayTag& Tag : SortedTags)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+		NetIndices.Add(NetIndex);
+		if (NetIndex != InvalidNetIndex)
+		{
+			MaxNetIndex = FMath::Max<int32>(MaxNetIndex, NetIndex);
+		}
+	}
+
+	TagLexicalRanks.Init(MAX_uint16, MaxNetIndex + 1);
+	TagParentNetIndices.Init(MAX_uint16, MaxNetIndex + 1);
+	for (int32 Rank = 0; Rank < NetIndices.Num(); ++Rank)
+	{
+		const FGameplayTagNetIndex NetIndex = NetIndices[Rank];
+		if (NetIndex == InvalidNetIndex)
+		{
+			continue;
+		}
+
+		TagLexicalRanks[NetIndex] = static_cast<uint16>(FMath::Min<int32>(Rank, MAX_uint16 - 1));
+
+		const FGameplayTag Parent = SortedTags[Rank].RequestDirectParent();
+		if (Parent.IsValid())
+		{
+			TagParentNetIndices[NetIndex] = TagsManager.GetNetIndexFromTag(Parent);
+		}
+	}
+
+	++TagRankVersion;
+}
+
+void FGASReflectionCache::HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	// Reinstancing replaces classes and their properties, cached property pointers may dangle
+	Reset();
+}
+
+void FGASReflectionCache::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+	Reset();
+}
+
+void FGASReflectionCache::HandleGameplayTagTreeChanged()
+{
+	// Tags were added or removed, ranks and net indices may have moved
+	TagLexicalRanks.Reset();
+	TagParentNetIndices.Reset();
+	++TagRankVersion;
+}
@@ -0,0 +1,160 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AttributeSet.h"
+
+class UClass;
+class UGameplayAbility;
+class UGameplayEffect;
+class UGameplayTask;
+class FArrayProperty;
+class FBoolProperty;
+class FStructProperty;
+struct FAbilityTriggerData;
+struct FGameplayTagContainer;
+enum class EReloadCompleteReason;
+
+/** Protected UGameplayAbility tag containers read through reflection */
+enum class EGASAbilityTagProperty : uint8
+{
+	ActivationOwned,
+	ActivationRequired,
+	ActivationBlocked,
+	SourceRequired,
+	SourceBlocked,
+	TargetRequired,
+	TargetBlocked,
+	CancelAbilitiesWith,
+	Num
+};
+
+/**
+ * Protected members of a UGameplayAbility subclass, resolved once per class.
+ * Readers return null when the class does not have the member.
+ */
+struct FGASAbilityClassInfo
+{
+	const FArrayProperty* AbilityTriggers = nullptr;
+	const FArrayProperty* ActiveTasks = nullptr;
+	const FBoolProperty* ActivateAbilityOnGranted = nullptr;
+	const FStructProperty* TagProperties[static_cast<int32>(EGASAbilityTagProperty::Num)] = {};
+
+	const TArray<FAbilityTriggerData>* GetAbilityTriggers(const UGameplayAbility* Ability) const;
+	const TArray<UGameplayTask*>* GetActiveTasks(const UGameplayAbility* Ability) const;
+	const FGameplayTagContainer* GetTags(const UGameplayAbility* Ability, EGASAbilityTagProperty Tags) const;
+	bool ActivatesOnGranted(const UGameplayAbility* Ability) const;
+};
+
+/** One FGameplayAttributeData member of an AttributeSet class */
+struct FGASAttributeLayoutEntry
+{
+	FGameplayAttribute Attribute;
+
+	/** Attribute name */
+	FName Name;
+
+	/** Offset of the FGameplayAttributeData inside the set */
+	int32 Offset = 0;
+};
+
+/** FGameplayAttributeData members of an AttributeSet class, in declaration order */
+struct FGASAttributeSetLayout
+{
+	FName SetName;
+	TArray<FGASAttributeLayoutEntry> Attributes;
+
+	/** Read an attribute of a set instance of this class */
+	static const FGameplayAttributeData& GetData(const UAttributeSet* Set, const FGASAttributeLayoutEntry& Entry)
+	{
+		return *reinterpret_cast<const FGameplayAttributeData*>(reinterpret_cast<const uint8*>(Set) + Entry.Offset);
+	}
+};
+
+/** Display names of a gameplay effect definition, built once instead of on every capture */
+struct FGASEffectDefinitionInfo
+{
+	/** Class name without the Blueprint _C suffix */
+	FName DisplayName;
+
+	/** Attribute name of each modifier, in definition order */
+	TArray<FName> ModifierAttributeNames;
+};
+
+/**
+ * Class-keyed cache of reflected GAS metadata, plus the lexical order of gameplay tags.
+ * Class entries are dropped when classes are reinstanced (Blueprint compile) or reloaded (hot reload / Live Coding),
+ * tag tables when the gameplay tag tree is rebuilt.
+ */
+class FGASReflectionCache
+{
+public:
+	/** Create the cache and bind the invalidation delegates, called on module startup */
+	static void Initialize();
+
+	/** Destroy the cache, called on module shutdown */
+	static void Shutdown();
+
+	static FGASReflectionCache& Get();
+
+	/** Get the metadata of an ability class, the reference is valid until the next lookup */
+	const FGASAbilityClassInfo& GetAbilityClassInfo(const UClass* AbilityClass);
+
+	/** Get the attribute layout of an AttributeSet class, the reference is valid until the next lookup */
+	const FGASAttributeSetLayout& GetAttributeSetLayout(const UClass* AttributeSetClass);
+
+	/** Get the display names of an effect definition, the reference is valid until the next lookup */
+	const FGASEffectDefinitionInfo& GetEffectDefinitionInfo(const UGameplayEffect* Definition);
+
+	/**
+	 * Get the lexical rank of every gameplay tag, indexed by net index
+	 * @param MaxNetIndex Highest net index the caller will look up, the table is rebuilt if it does not cover it
+	 */
+	const TArray<uint16>& GetTagLexicalRanks(uint16 MaxNetIndex);
+
+	/**
+	 * Get the net index of the direct parent of every gameplay tag, indexed by net index
+	 * @param MaxNetIndex Highest net index the caller will look up, the table is rebuilt if it does not cover it
+	 */
+	const TArray<uint16>& GetTagParentNetIndices(uint16 MaxNetIndex);
+
+	/** Incremented every time the tag rank table is rebuilt */
+	uint32 GetTagRankVersion() const { return TagRankVersion; }
+
+	/** Drop every cached entry */
+	void Reset();
+
+private:
+	FGASReflectionCache();
+	~FGASReflectionCache();
+
+	FGASAbilityClassInfo BuildAbilityClassInfo(const UClass* AbilityClass) const;
+	FGASAttributeSetLayout BuildAttributeSetLayout(const UClass* AttributeSetClass) const;
+	FGASEffectDefinitionInfo BuildEffectDefinitionInfo(const UGameplayEffect* Definition) const;
+	void EnsureTagTables(uint16 MaxNetIndex);
+	void BuildTagTables();
+
+	void HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+	void HandleGameplayTagTreeChanged();
+
+private:
+	static FGASReflectionCache* Instance;
+
+	TMap<TObjectKey<UClass>, FGASAbilityClassInfo> AbilityClasses;
+	TMap<TObjectKey<UClass>, FGASAttributeSetLayout> AttributeSetLayouts;
+	TMap<TObjectKey<UGameplayEffect>, FGASEffectDefinitionInfo> EffectDefinitions;
+
+	/** Rank of each tag in name order, indexed by net index, MAX_uint16 for unknown indices */
+	TArray<uint16> TagLexicalRanks;
+
+	/** Net index of the parent of each tag, indexed by net index, MAX_uint16 for root tags */
+	TArray<uint16> TagParentNetIndices;
+	uint32 TagRankVersion = 0;
+
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle TagTreeChangedHandle;
+};
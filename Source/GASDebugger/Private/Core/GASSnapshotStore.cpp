@@ -0,0 +1,149 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASSnapshotStore.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASDebuggerStats.h"
+#include "AbilitySystemComponent.h"
+#include "HAL/PlatformTime.h"
+
+namespace GASSnapshotStore
+{
+	/** Frames an entry survives without being acquired */
+	static constexpr uint64 EntryTimeoutFrames = 600;
+
+	/** Frames between two prune passes */
+	static constexpr uint64 PruneIntervalFrames = 60;
+}
+
+FGASSnapshotStore* FGASSnapshotStore::Instance = nullptr;
+
+void FGASSnapshotStore::Initialize()
+{
+	if (!Instance)
+	{
+		Instance = new FGASSnapshotStore();
+	}
+}
+
+void FGASSnapshotStore::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FGASSnapshotStore& FGASSnapshotStore::Get()
+{
+	check(Instance);
+	return *Instance;
+}
+
+const FGASSnapshot& FGASSnapshotStore::Acquire(UAbilitySystemComponent* ASC, uint8 InCategories)
+{
+	check(IsInGameThread());
+
+	if (GFrameCounter - LastPruneFrame >= GASSnapshotStore::PruneIntervalFrames)
+	{
+		PruneEntries();
+	}
+
+	TUniquePtr<FEntry>& EntryPtr = Entries.FindOrAdd(ASC);
+	if (!EntryPtr.IsValid())
+	{
+		EntryPtr = MakeUnique<FEntry>();
+		EntryPtr->ASC = ASC;
+	}
+
+	FEntry& Entry = *EntryPtr;
+	Entry.LastAcquireFrame = GFrameCounter;
+
+	// Another consumer already read this ASC this frame, only fill in what it did not ask for
+	FGASSnapshot& Front = Entry.Buffers[Entry.FrontIndex];
+	if (Front.Frame == GFrameCounter)
+	{
+		const uint8 MissingCategories = InCategories & ~Front.Categories;
+		if (MissingCategories != 0)
+		{
+			Capture(ASC, MissingCategories, Front);
+		}
+		return Front;
+	}
+
+	// First read this frame, the front stays untouched until the back is complete
+	const int32 BackIndex = Entry.FrontIndex ^ 1;
+	FGASSnapshot& Back = Entry.Buffers[BackIndex];
+	Back.Frame = GFrameCounter;
+	Back.Categories = 0;
+	Capture(ASC, InCategories, Back);
+
+	Entry.FrontIndex = BackIndex;
+	return Back;
+}
+
+const FGASSnapshot* FGASSnapshotStore::FindLatest(const UAbilitySystemComponent* ASC) const
+{
+	const TUniquePtr<FEntry>* EntryPtr = Entries.Find(ASC);
+	const FEntry* Entry = EntryPtr ? EntryPtr->Get() : nullptr;
+	if (!Entry || Entry->Buffers[Entry->FrontIndex].Categories == 0)
+	{
+		return nullptr;
+	}
+	return &Entry->Buffers[Entry->FrontIndex];
+}
+
+void FGASSnapshotStore::Reset()
+{
+	Entries.Reset();
+}
+
+void FGASSnapshotStore::Capture(UAbilitySystemComponent* ASC, uint8 InCategories, FGASSnapshot& OutSnapshot)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const SIZE_T AllocatedSizeBefore = OutSnapshot.GetAllocatedSize();
+	OutSnapshot.Categories |= InCategories;
+
+	if (InCategories & GASDebugCategoryBit(EGASDebugCategory::Tags))
+	{
+		// Containers keep their allocation across captures
+		OutSnapshot.OwnedTags.Reset();
+		ASC->GetOwnedGameplayTags(OutSnapshot.OwnedTags);
+		OutSnapshot.BlockedTags.Reset();
+		ASC->GetBlockedAbilityTags(OutSnapshot.BlockedTags);
+		++CaptureCount;
+	}
+
+	if (InCategories & GASDebugCategoryBit(EGASDebugCategory::GameplayEffects))
+	{
+		FGASDataProvider::CaptureActiveEffects(ASC, OutSnapshot.Effects);
+		++CaptureCount;
+	}
+
+	if (InCategories & GASDebugCategoryBit(EGASDebugCategory::Attributes))
+	{
+		FGASDataProvider::CaptureAttributes(ASC, OutSnapshot.Attributes);
+		FGASDataProvider::BuildAttributeModifierIndex(ASC, OutSnapshot.Modifiers);
+		++CaptureCount;
+	}
+
+	// Buffers are reused, only growth is a new allocation
+	const SIZE_T AllocatedSizeAfter = OutSnapshot.GetAllocatedSize();
+	if (AllocatedSizeAfter > AllocatedSizeBefore)
+	{
+		INC_DWORD_STAT_BY(STAT_GASDebugger_BytesAllocated, AllocatedSizeAfter - AllocatedSizeBefore);
+	}
+
+	CaptureSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void FGASSnapshotStore::PruneEntries()
+{
+	LastPruneFrame = GFrameCounter;
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const FEntry& Entry = *It.Value();
+		if (!Entry.ASC.IsValid() || GFrameCounter - Entry.LastAcquireFrame > GASSnapshotStore::EntryTimeoutFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,114 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayTagContainer.h"
+#include "GASDebuggerTypes.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * GAS state of one ASC captured in one frame.
+ * Only the categories in Categories are filled, the others hold data of an older frame.
+ */
+struct FGASSnapshot
+{
+	/** GFrameCounter of the capture */
+	uint64 Frame = 0;
+
+	/** Mask of the captured categories, see GASDebugCategoryBit */
+	uint8 Categories = 0;
+
+	// Tags
+	FGameplayTagContainer OwnedTags;
+	FGameplayTagContainer BlockedTags;
+
+	// GameplayEffects, in container order
+	TArray<FGASEffectSnapshot> Effects;
+
+	// Attributes
+	TArray<FGASAttributeInfo> Attributes;
+	FGASAttributeModifierIndex Modifiers;
+
+	bool HasCategory(EGASDebugCategory Category) const
+	{
+		return (Categories & GASDebugCategoryBit(Category)) != 0;
+	}
+
+	/** Heap size of the captured containers, tag containers count their explicit tags only */
+	SIZE_T GetAllocatedSize() const
+	{
+		return OwnedTags.GetGameplayTagArray().GetAllocatedSize() + BlockedTags.GetGameplayTagArray().GetAllocatedSize()
+			+ Effects.GetAllocatedSize() + Attributes.GetAllocatedSize() + Modifiers.Modifiers.GetAllocatedSize();
+	}
+};
+
+/**
+ * Per-ASC snapshots shared by every tab of every debugger window.
+ * An ASC is read at most once per frame and category however many consumers watch it.
+ * Each ASC has two buffers: a frame's capture fills the back buffer, then becomes the front,
+ * so a snapshot handed out stays intact until a capture of a later frame replaces it.
+ * Abilities are not captured, ability nodes read their spec and instances directly.
+ */
+class FGASSnapshotStore
+{
+public:
+	/** Create the store, called on module startup */
+	static void Initialize();
+
+	/** Destroy the store, called on module shutdown */
+	static void Shutdown();
+
+	static FGASSnapshotStore& Get();
+
+	/**
+	 * Get the snapshot of an ASC for the current frame, capturing what this frame has not read yet
+	 * @param ASC The ability system component to capture
+	 * @param InCategories Mask of the categories the caller reads
+	 * @return Snapshot holding at least InCategories, valid until the next frame's capture of the same ASC
+	 */
+	const FGASSnapshot& Acquire(UAbilitySystemComponent* ASC, uint8 InCategories);
+
+	/** Get the last complete snapshot of an ASC without capturing, null if it was never captured */
+	const FGASSnapshot* FindLatest(const UAbilitySystemComponent* ASC) const;
+
+	/** Number of ASCs with snapshots */
+	int32 Num() const { return Entries.Num(); }
+
+	/** Number of category captures since startup, for measuring sharing */
+	uint64 GetCaptureCount() const { return CaptureCount; }
+
+	/** Time spent capturing since startup, for the debugger's overhead display */
+	double GetCaptureSeconds() const { return CaptureSeconds; }
+
+	/** Drop every snapshot */
+	void Reset();
+
+private:
+	FGASSnapshotStore() {}
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> ASC;
+		FGASSnapshot Buffers[2];
+		int32 FrontIndex = 0;
+		uint64 LastAcquireFrame = 0;
+	};
+
+	/** Read the given categories of an ASC into a snapshot, the snapshot's storage is reused */
+	void Capture(UAbilitySystemComponent* ASC, uint8 InCategories, FGASSnapshot& OutSnapshot);
+
+	/** Drop entries of destroyed ASCs and of ASCs nobody acquired for a while */
+	void PruneEntries();
+
+private:
+	static FGASSnapshotStore* Instance;
+
+	/** Entries are heap allocated so handed out snapshots survive the map growing */
+	TMap<TObjectKey<UAbilitySystemComponent>, TUniquePtr<FEntry>> Entries;
+	uint64 LastPruneFrame = 0;
+	uint64 CaptureCount = 0;
+	double CaptureSeconds = 0.0;
+};
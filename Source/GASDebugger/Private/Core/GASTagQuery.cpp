@@ -0,0 +1,171 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASTagQuery.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASSnapshotStore.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
+
+#define LOCTEXT_NAMESPACE "GASTagQuery"
+
+//////////////////////////////////////////////////////////////////////////
+// FGASTagBitQuery
+
+FGASTagBitQuery FGASTagBitQuery::Compile(const FGameplayTagQuery& Query)
+{
+	FGameplayTagQueryExpression Expression;
+	Query.GetQueryExpr(Expression);
+	return CompileExpression(Expression);
+}
+
+FGASTagBitQuery FGASTagBitQuery::CompileExpression(const FGameplayTagQueryExpression& Expression)
+{
+	FGASTagBitQuery Result;
+
+	switch (Expression.ExprType)
+	{
+	case EGameplayTagQueryExprType::AnyTagsMatch:
+		Result.Op = EOp::AnyTags;
+		break;
+	case EGameplayTagQueryExprType::AllTagsMatch:
+		Result.Op = EOp::AllTags;
+		break;
+	case EGameplayTagQueryExprType::NoTagsMatch:
+		Result.Op = EOp::NoTags;
+		break;
+	case EGameplayTagQueryExprType::AnyExprMatch:
+		Result.Op = EOp::AnyExpr;
+		break;
+	case EGameplayTagQueryExprType::AllExprMatch:
+		Result.Op = EOp::AllExpr;
+		break;
+	case EGameplayTagQueryExprType::NoExprMatch:
+		Result.Op = EOp::NoExpr;
+		break;
+	default:
+		// Undefined and exact-match expressions
+		return Result;
+	}
+
+	// Query tags are not expanded, the captured bitsets already hold every parent
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const FGameplayTagNetIndex InvalidNetIndex = TagsManager.GetInvalidTagNetIndex();
+	for (const FGameplayTag& Tag : Expression.TagSet)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+		if (NetIndex != InvalidNetIndex)
+		{
+			Result.Mask.SetBit(NetIndex);
+		}
+	}
+
+	for (const FGameplayTagQueryExpression& Child : Expression.ExprSet)
+	{
+		Result.Children.Add(CompileExpression(Child));
+	}
+
+	return Result;
+}
+
+bool FGASTagBitQuery::Matches(const FGASTagBitset& Tags) const
+{
+	switch (Op)
+	{
+	case EOp::AnyTags:
+		return Tags.HasAny(Mask);
+	case EOp::AllTags:
+		return Tags.HasAll(Mask);
+	case EOp::NoTags:
+		return !Tags.HasAny(Mask);
+	case EOp::AnyExpr:
+		return Children.ContainsByPredicate([&Tags](const FGASTagBitQuery& Child) { return Child.Matches(Tags); });
+	case EOp::AllExpr:
+		return !Children.ContainsByPredicate([&Tags](const FGASTagBitQuery& Child) { return !Child.Matches(Tags); });
+	case EOp::NoExpr:
+		return !Children.ContainsByPredicate([&Tags](const FGASTagBitQuery& Child) { return Child.Matches(Tags); });
+	default:
+		return false;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FGASTagQueryIndex
+
+bool FGASTagQueryIndex::ParseQueryText(const FString& Text, FGameplayTagQuery& OutQuery, FText& OutError)
+{
+	OutQuery = FGameplayTagQuery();
+
+	TArray<FString> Terms;
+	Text.ParseIntoArrayWS(Terms, TEXT(","));
+	if (Terms.Num() == 0)
+	{
+		return true;
+	}
+
+	FGameplayTagContainer RequiredTags;
+	FGameplayTagContainer ExcludedTags;
+	for (const FString& Term : Terms)
+	{
+		const bool bExcluded = Term.StartsWith(TEXT("!"));
+		const FString TagName = bExcluded ? Term.RightChop(1) : Term;
+
+		const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName), false);
+		if (!Tag.IsValid())
+		{
+			OutError = FText::Format(LOCTEXT("UnknownTag", "Unknown tag '{0}'"), FText::FromString(TagName));
+			return false;
+		}
+
+		(bExcluded ? ExcludedTags : RequiredTags).AddTag(Tag);
+	}
+
+	FGameplayTagQueryExpression Expression;
+	Expression.AllExprMatch()
+		.AddExpr(FGameplayTagQueryExpression().AllTagsMatch().AddTags(RequiredTags))
+		.AddExpr(FGameplayTagQueryExpression().NoTagsMatch().AddTags(ExcludedTags));
+
+	OutQuery = FGameplayTagQuery::BuildQuery(Expression);
+	return true;
+}
+
+void FGASTagQueryIndex::Capture(const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Components)
+{
+	if (Entries.Num() < Components.Num())
+	{
+		Entries.SetNum(Components.Num());
+	}
+
+	NumEntries = 0;
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& Component : Components)
+	{
+		UAbilitySystemComponent* ASC = Component.Get();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		// Tags already read this frame by a tab or another window are not read again
+		const FGASSnapshot& Snapshot = FGASSnapshotStore::Get().Acquire(ASC, GASDebugCategoryBit(EGASDebugCategory::Tags));
+
+		FEntry& Entry = Entries[NumEntries++];
+		Entry.ASC = Component;
+		FGASDataProvider::CaptureTagBitset(Snapshot.OwnedTags, Entry.OwnedTags);
+	}
+}
+
+void FGASTagQueryIndex::Query(const FGASTagBitQuery& InQuery, TArray<TWeakObjectPtr<UAbilitySystemComponent>>& OutComponents) const
+{
+	OutComponents.Reset();
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		if (InQuery.Matches(Entry.OwnedTags))
+		{
+			OutComponents.Add(Entry.ASC);
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,75 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GASDebuggerTypes.h"
+
+class UAbilitySystemComponent;
+struct FGameplayTagQuery;
+struct FGameplayTagQueryExpression;
+
+/**
+ * FGameplayTagQuery compiled to bitset masks.
+ * Matching against parent-expanded bitsets gives the same result as FGameplayTagQuery::Matches,
+ * exact-match expressions are not supported and never match.
+ */
+struct FGASTagBitQuery
+{
+	enum class EOp : uint8
+	{
+		Never,
+		AnyTags,
+		AllTags,
+		NoTags,
+		AnyExpr,
+		AllExpr,
+		NoExpr
+	};
+
+	EOp Op = EOp::Never;
+	FGASTagBitset Mask;
+	TArray<FGASTagBitQuery> Children;
+
+	static FGASTagBitQuery Compile(const FGameplayTagQuery& Query);
+
+	bool Matches(const FGASTagBitset& Tags) const;
+
+private:
+	static FGASTagBitQuery CompileExpression(const FGameplayTagQueryExpression& Expression);
+};
+
+/**
+ * Owned tags of a set of ASCs as bitsets, so one query runs over all of them with word-wise operations.
+ */
+class FGASTagQueryIndex
+{
+public:
+	/**
+	 * Parse the query box syntax: every plain tag is required, '!' prefixed tags must be absent
+	 * @param Text e.g. "State.Stunned !Immune.CC"
+	 * @param OutQuery Receives the query, empty for empty text
+	 * @param OutError Receives the reason when the text cannot be parsed
+	 */
+	static bool ParseQueryText(const FString& Text, FGameplayTagQuery& OutQuery, FText& OutError);
+
+	/** Recapture the tags of every component, the storage of previous captures is reused */
+	void Capture(const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& Components);
+
+	/** Collect the components whose owned tags match, in capture order */
+	void Query(const FGASTagBitQuery& InQuery, TArray<TWeakObjectPtr<UAbilitySystemComponent>>& OutComponents) const;
+
+	/** Number of captured components */
+	int32 Num() const { return NumEntries; }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> ASC;
+		FGASTagBitset OwnedTags;
+	};
+
+	/** Entries past NumEntries are kept only for their storage */
+	TArray<FEntry> Entries;
+	int32 NumEntries = 0;
+};
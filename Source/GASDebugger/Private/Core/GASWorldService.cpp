@@ -0,0 +1,136 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASWorldService.h"
+#include "Core/GASASCRegistry.h"
+#include "Engine/Engine.h"
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "GASWorldService"
+
+namespace GASWorldService
+{
+	static FText GetContextDisplayName(const FWorldContext& Context)
+	{
+		if (Context.RunAsDedicated)
+		{
+			return LOCTEXT("Dedicated", "Dedicated Server");
+		}
+		if (Context.WorldType == EWorldType::Game)
+		{
+			return LOCTEXT("Client", "Client");
+		}
+		return FText::Format(FText::FromString("{0} [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(Context.PIEInstance));
+	}
+}
+
+FGASWorldService::FGASWorldService()
+{
+	PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FGASWorldService::HandlePostWorldInitialization);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FGASWorldService::HandleWorldCleanup);
+#if WITH_EDITOR
+	PostPIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FGASWorldService::HandlePIEStartedOrEnded);
+	EndPIEHandle = FEditorDelegates::EndPIE.AddRaw(this, &FGASWorldService::HandlePIEStartedOrEnded);
+#endif
+}
+
+FGASWorldService::~FGASWorldService()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+#if WITH_EDITOR
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+#endif
+}
+
+const TArray<FGASWorldContextInfo>& FGASWorldService::GetWorldContexts()
+{
+	UpdateWorldContexts();
+	return WorldContexts;
+}
+
+const FGASWorldContextInfo* FGASWorldService::FindWorldContext(FName ContextHandle)
+{
+	UpdateWorldContexts();
+
+	for (const FGASWorldContextInfo& Info : WorldContexts)
+	{
+		if (Info.ContextHandle == ContextHandle)
+		{
+			return &Info;
+		}
+	}
+
+	// Return first valid world if no specific selection
+	return WorldContexts.Num() > 0 ? &WorldContexts[0] : nullptr;
+}
+
+TSharedRef<FGASASCRegistry> FGASWorldService::GetRegistry(UWorld* World)
+{
+	TSharedPtr<FGASASCRegistry>& Registry = Registries.FindOrAdd(World);
+	if (!Registry.IsValid())
+	{
+		// The registry scans the world once, after that it is kept current by spawn/destroy events
+		Registry = MakeShared<FGASASCRegistry>(World);
+	}
+	return Registry.ToSharedRef();
+}
+
+void FGASWorldService::UpdateWorldContexts()
+{
+	// Only world events change the list, lookups in between do not walk the engine's contexts
+	if (!bWorldContextsDirty || !GEngine)
+	{
+		return;
+	}
+	bWorldContextsDirty = false;
+
+	WorldContexts.Reset();
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
+		{
+			FGASWorldContextInfo& Info = WorldContexts.AddDefaulted_GetRef();
+			Info.ContextHandle = Context.ContextHandle;
+			Info.World = Context.World();
+			Info.DisplayName = GASWorldService::GetContextDisplayName(Context);
+		}
+	}
+}
+
+void FGASWorldService::MarkWorldsChanged()
+{
+	// Windows only invalidate here, the contexts are rescanned on the next lookup
+	bWorldContextsDirty = true;
+	OnWorldsChanged.Broadcast();
+}
+
+void FGASWorldService::HandlePostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+	if (World && (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game))
+	{
+		MarkWorldsChanged();
+	}
+}
+
+void FGASWorldService::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// The registry listens to the world's spawn events, release it while the world is still valid
+	Registries.Remove(World);
+
+	if (World && (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game))
+	{
+		MarkWorldsChanged();
+	}
+}
+
+#if WITH_EDITOR
+void FGASWorldService::HandlePIEStartedOrEnded(bool bIsSimulating)
+{
+	MarkWorldsChanged();
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,72 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/World.h"
+
+class FGASASCRegistry;
+
+/** A world context the debugger can inspect */
+struct FGASWorldContextInfo
+{
+	FName ContextHandle;
+	TWeakObjectPtr<UWorld> World;
+
+	/** Selector text, e.g. "Client [1]" or "Dedicated Server" */
+	FText DisplayName;
+};
+
+/**
+ * World lookups and ASC registries shared by every debugger window, owned by FGASDebuggerModule.
+ * World contexts are only rescanned after world initialization, world cleanup or PIE start/end,
+ * and each world has a single ASC registry, however many windows are open.
+ */
+class FGASWorldService
+{
+public:
+	DECLARE_MULTICAST_DELEGATE(FOnWorldsChanged);
+
+	/** Broadcast when a world is initialized or cleaned up, or a PIE session starts or ends */
+	FOnWorldsChanged OnWorldsChanged;
+
+	FGASWorldService();
+	~FGASWorldService();
+
+	/** Get the PIE and Game world contexts, in engine order */
+	const TArray<FGASWorldContextInfo>& GetWorldContexts();
+
+	/** Resolve a context handle, falls back to the first context when the handle is not found */
+	const FGASWorldContextInfo* FindWorldContext(FName ContextHandle);
+
+	/** Get the ASC registry of a world, created on first request and shared by every caller */
+	TSharedRef<FGASASCRegistry> GetRegistry(UWorld* World);
+
+private:
+	/** Rescan the engine's world contexts if a world event invalidated them */
+	void UpdateWorldContexts();
+
+	/** Invalidate the world contexts and notify the windows */
+	void MarkWorldsChanged();
+
+	void HandlePostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+#if WITH_EDITOR
+	void HandlePIEStartedOrEnded(bool bIsSimulating);
+#endif
+
+private:
+	TArray<FGASWorldContextInfo> WorldContexts;
+	bool bWorldContextsDirty = true;
+
+	/** Registries are dropped with their world */
+	TMap<TObjectKey<UWorld>, TSharedPtr<FGASASCRegistry>> Registries;
+
+	FDelegateHandle PostWorldInitializationHandle;
+	FDelegateHandle WorldCleanupHandle;
+#if WITH_EDITOR
+	FDelegateHandle PostPIEStartedHandle;
+	FDelegateHandle EndPIEHandle;
+#endif
+};
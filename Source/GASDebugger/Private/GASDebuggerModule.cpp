@@ -5,6 +5,10 @@
 #include "GASDebuggerCommands.h"
 #include "Core/GASDebuggerSharedState.h"
 #include "Core/GASDebuggerWindowInstance.h"
+#include "Core/GASFlightRecorder.h"
+#include "Core/GASReflectionCache.h"
+#include "Core/GASSnapshotStore.h"
+#include "Core/GASWorldService.h"
 #include "Widgets/SGASDebuggerMainWindow.h"
 #include "Widgets/Tabs/SGASDebuggerTagsTab.h"
 #include "Widgets/Tabs/SGASDebuggerAttributesTab.h"
@@ -26,6 +30,11 @@
 
 void FGASDebuggerModule::StartupModule()
 {
+	FGASReflectionCache::Initialize();
+	FGASSnapshotStore::Initialize();
+	FGASFlightRecorder::Initialize();
+	WorldService = MakeShared<FGASWorldService>();
+
 #if WITH_EDITOR
 	// Initialize style and commands
 	FGASDebuggerStyle::Initialize();
@@ -67,6 +76,13 @@ void FGASDebuggerModule::ShutdownModule()
 	}
 	WindowInstances.Empty();
 #endif
+
+	// The recorder holds a registry of the world service
+	FGASFlightRecorder::Shutdown();
+	WorldService.Reset();
+
+	FGASSnapshotStore::Shutdown();
+	FGASReflectionCache::Shutdown();
 }
 
 FGASDebuggerModule& FGASDebuggerModule::Get()
@@ -74,13 +90,19 @@ FGASDebuggerModule& FGASDebuggerModule::Get()
 	return FModuleManager::LoadModuleChecked<FGASDebuggerModule>("GASDebugger");
 }
 
+FGASWorldService& FGASDebuggerModule::GetWorldService() const
+{
+	check(WorldService.IsValid());
+	return *WorldService;
+}
+
 void FGASDebuggerModule::SpawnNewDebuggerWindow()
 {
 #if WITH_EDITOR
 	int32 InstanceId = NextInstanceId++;
 
 	// Create window instance
-	TSharedPtr<FGASDebuggerWindowInstance> Instance = MakeShared<FGASDebuggerWindowInstance>(InstanceId);
+	TSharedPtr<FGASDebuggerWindowInstance> Instance = MakeShared<FGASDebuggerWindowInstance>(InstanceId, WorldService.ToSharedRef());
 	WindowInstances.Add(InstanceId, Instance);
 
 	FName TabName = Instance->GetMainTabId();
@@ -171,7 +193,7 @@ TSharedRef<SDockTab> FGASDebuggerModule::OnSpawnDebuggerTab(const FSpawnTabArgs&
 	if (!Instance.IsValid())
 	{
 		// Instance should have been created in SpawnNewDebuggerWindow, but handle edge case
-		Instance = MakeShared<FGASDebuggerWindowInstance>(InstanceId);
+		Instance = MakeShared<FGASDebuggerWindowInstance>(InstanceId, WorldService.ToSharedRef());
 		WindowInstances.Add(InstanceId, Instance);
 	}
 
@@ -0,0 +1,76 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Core/GASDebuggerBenchmarkSuite.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GASDebuggerBenchmarkTest
+{
+	/** Transient game world for runs without PIE, the debugger selects Game worlds like PIE ones */
+	static UWorld* CreateGameWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GASDebuggerBenchmark"));
+		FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+		Context.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	static void DestroyGameWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+/**
+ * Runs GASDebugger.Benchmark.Suite and fails when a measurement misses its regression threshold.
+ * Headless: UnrealEditor-Cmd <Project>.uproject -nullrhi -unattended -ExecCmds="Automation RunTests GASDebugger.Benchmark.Suite;Quit"
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FGASDebuggerBenchmarkSuiteTest, "GASDebugger.Benchmark.Suite",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FGASDebuggerBenchmarkSuiteTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	const FString OutputDir = FPaths::ProjectSavedDir() / TEXT("GASDebugger");
+
+	// Small is quick enough for every CI pass, Full covers every scale up to 10000 ASCs
+	OutBeautifiedNames.Add(TEXT("Small"));
+	OutTestCommands.Add(FString::Printf(TEXT("MaxASCs=100 Output=%s"), *(OutputDir / TEXT("Benchmark-Small.json"))));
+
+	OutBeautifiedNames.Add(TEXT("Full"));
+	OutTestCommands.Add(FString::Printf(TEXT("Output=%s"), *(OutputDir / TEXT("Benchmark-Full.json"))));
+}
+
+bool FGASDebuggerBenchmarkSuiteTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Args;
+	Parameters.ParseIntoArrayWS(Args);
+	const GASDebuggerBenchmark::FSuiteArgs SuiteArgs = GASDebuggerBenchmark::ParseSuiteArgs(Args);
+
+	// A running PIE session is used as is, otherwise the suite gets a world of its own
+	UWorld* World = GASDebuggerBenchmark::FindBenchmarkWorld(nullptr);
+	const bool bOwnsWorld = World == nullptr;
+	if (bOwnsWorld)
+	{
+		World = GASDebuggerBenchmarkTest::CreateGameWorld();
+	}
+
+	// Measurements over their threshold are also logged as errors, which the test reports with their numbers
+	const bool bPassed = GASDebuggerBenchmark::RunSuite(SuiteArgs, World, *GLog);
+	TestTrue(TEXT("Every measurement is within its regression threshold"), bPassed);
+
+	if (bOwnsWorld)
+	{
+		GASDebuggerBenchmarkTest::DestroyGameWorld(World);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
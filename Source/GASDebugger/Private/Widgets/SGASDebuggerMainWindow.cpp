@@ -2,18 +2,22 @@
 
 #include "Widgets/SGASDebuggerMainWindow.h"
 #include "Core/GASDebuggerSharedState.h"
+#include "Core/GASFlightRecorder.h"
+#include "Core/GASTagQuery.h"
+#include "Core/GASWorldService.h"
 #include "GASDebuggerModule.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSeparator.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
-#include "Engine/Engine.h"
 #include "Engine/World.h"
+#include "HAL/PlatformTime.h"
 #include "AbilitySystemComponent.h"
 
 #define LOCTEXT_NAMESPACE "SGASDebuggerMainWindow"
@@ -75,14 +79,28 @@ SGASDebuggerMainWindow::~SGASDebuggerMainWindow()
 	}
 }
 
+int32 SGASDebuggerMainWindow::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 MaxLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	// The tabs report their own paint time, together they make the window's cost
+	if (SharedState.IsValid())
+	{
+		SharedState->AddPaintCost(FPlatformTime::Seconds() - StartTime);
+	}
+	return MaxLayerId;
+}
+
 void SGASDebuggerMainWindow::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-	// In picking mode, continuously refresh data
-	if (SharedState.IsValid() && SharedState->IsPickingMode())
+	// The shared state decides whether a refresh pass is due (pending request or Tick mode interval)
+	if (SharedState.IsValid())
 	{
-		SharedState->RequestRefresh();
+		SharedState->Tick();
 	}
 }
 
@@ -140,6 +158,14 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildTopBar()
 				]
 			]
 
+			// Actor tag query
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(2.f)
+			[
+				BuildTagQueryBox()
+			]
+
 			// Actor selector
 			+ SHorizontalBox::Slot()
 			.FillWidth(1.f)
@@ -148,6 +174,32 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildTopBar()
 				BuildActorSelector()
 			]
 
+			// Flight recorder
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(2.f)
+			[
+				SNew(SCheckBox)
+				.Padding(FMargin(4, 0))
+				.IsChecked(this, &SGASDebuggerMainWindow::GetRecordingCheckState)
+				.OnCheckStateChanged(this, &SGASDebuggerMainWindow::HandleRecordingChanged)
+				.ToolTipText(this, &SGASDebuggerMainWindow::GetRecordingToolTipText)
+				[
+					SNew(STextBlock)
+					.Text(this, &SGASDebuggerMainWindow::GetRecordingText)
+				]
+			]
+
+			// Debugger overhead and frame budget
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(4.f, 0.f)
+			[
+				BuildOverheadDisplay()
+			]
+
 			// Separator before new window button
 			+ SHorizontalBox::Slot()
 			.AutoWidth()
@@ -170,42 +222,60 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildTopBar()
 		];
 }
 
-TSharedRef<SWidget> SGASDebuggerMainWindow::BuildWorldSelector()
+TSharedRef<SWidget> SGASDebuggerMainWindow::BuildOverheadDisplay()
 {
 	return SNew(SComboButton)
 		.OnGetMenuContent_Lambda([this]() -> TSharedRef<SWidget>
 		{
 			FMenuBuilder MenuBuilder(true, nullptr);
+			MenuBuilder.BeginSection(NAME_None, LOCTEXT("FrameBudget", "Frame Budget"));
 
-			if (!GEngine)
+			// 0 turns the budget off
+			static const float BudgetOptionsMs[] = { 0.f, 0.25f, 0.5f, 1.f, 2.f };
+			for (const float BudgetMs : BudgetOptionsMs)
 			{
-				return MenuBuilder.MakeWidget();
+				const FText Label = BudgetMs > 0.f
+					? FText::Format(LOCTEXT("FrameBudgetOption", "{0} ms"), FText::AsNumber(BudgetMs))
+					: LOCTEXT("FrameBudgetOff", "Off");
+
+				FUIAction Action(
+					FExecuteAction::CreateSP(this, &SGASDebuggerMainWindow::HandleFrameBudgetSelected, BudgetMs),
+					FCanExecuteAction(),
+					FIsActionChecked::CreateSP(this, &SGASDebuggerMainWindow::IsFrameBudgetSelected, BudgetMs));
+				MenuBuilder.AddMenuEntry(Label, FText::GetEmpty(), FSlateIcon(), Action, NAME_None, EUserInterfaceActionType::RadioButton);
 			}
 
-			const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
+			MenuBuilder.EndSection();
+			return MenuBuilder.MakeWidget();
+		})
+		.VAlign(VAlign_Center)
+		.ContentPadding(2)
+		.ButtonContent()
+		[
+			SNew(STextBlock)
+			.Text(this, &SGASDebuggerMainWindow::GetOverheadText)
+			.ToolTipText(this, &SGASDebuggerMainWindow::GetOverheadToolTipText)
+			.ColorAndOpacity(this, &SGASDebuggerMainWindow::GetOverheadColor)
+		];
+}
 
-			for (const FWorldContext& Context : WorldList)
-			{
-				if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
-				{
-					FUIAction Action(FExecuteAction::CreateSP(this, &SGASDebuggerMainWindow::HandleWorldSelectionChanged, Context.ContextHandle));
+TSharedRef<SWidget> SGASDebuggerMainWindow::BuildWorldSelector()
+{
+	return SNew(SComboButton)
+		.OnGetMenuContent_Lambda([this]() -> TSharedRef<SWidget>
+		{
+			FMenuBuilder MenuBuilder(true, nullptr);
 
-					FText DisplayName;
-					if (Context.RunAsDedicated)
-					{
-						DisplayName = LOCTEXT("Dedicated", "Dedicated Server");
-					}
-					else if (Context.WorldType == EWorldType::Game)
-					{
-						DisplayName = LOCTEXT("Client", "Client");
-					}
-					else
-					{
-						DisplayName = FText::Format(FText::FromString("{0} [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(Context.PIEInstance));
-					}
+			if (!SharedState.IsValid())
+			{
+				return MenuBuilder.MakeWidget();
+			}
 
-					MenuBuilder.AddMenuEntry(DisplayName, FText::GetEmpty(), FSlateIcon(), Action);
-				}
+			// The world list is shared by every window, scanned at most once per frame
+			for (const FGASWorldContextInfo& Context : SharedState->GetWorldService().GetWorldContexts())
+			{
+				FUIAction Action(FExecuteAction::CreateSP(this, &SGASDebuggerMainWindow::HandleWorldSelectionChanged, Context.ContextHandle));
+				MenuBuilder.AddMenuEntry(Context.DisplayName, FText::GetEmpty(), FSlateIcon(), Action);
 			}
 
 			return MenuBuilder.MakeWidget();
@@ -222,33 +292,6 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildWorldSelector()
 
 void SGASDebuggerMainWindow::HandleWorldSelectionChanged(FName InContextHandle)
 {
-	if (!GEngine)
-	{
-		return;
-	}
-
-	// Update display text
-	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-	for (const FWorldContext& Context : WorldList)
-	{
-		if (Context.ContextHandle == InContextHandle)
-		{
-			if (Context.RunAsDedicated)
-			{
-				SelectedWorldText = LOCTEXT("Dedicated", "Dedicated Server");
-			}
-			else if (Context.WorldType == EWorldType::Game)
-			{
-				SelectedWorldText = LOCTEXT("Client", "Client");
-			}
-			else
-			{
-				SelectedWorldText = FText::Format(FText::FromString("{0} [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(Context.PIEInstance));
-			}
-			break;
-		}
-	}
-
 	if (SharedState.IsValid())
 	{
 		SharedState->SetSelectedWorld(InContextHandle);
@@ -257,34 +300,11 @@ void SGASDebuggerMainWindow::HandleWorldSelectionChanged(FName InContextHandle)
 
 FText SGASDebuggerMainWindow::GetWorldSelectorText() const
 {
-	if (SelectedWorldText.IsEmpty())
-	{
-		// Try to get first available world
-		if (GEngine)
-		{
-			const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-			for (const FWorldContext& Context : WorldList)
-			{
-				if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
-				{
-					if (Context.RunAsDedicated)
-					{
-						return LOCTEXT("Dedicated", "Dedicated Server");
-					}
-					else if (Context.WorldType == EWorldType::Game)
-					{
-						return LOCTEXT("Client", "Client");
-					}
-					else
-					{
-						return FText::Format(FText::FromString("{0} [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(Context.PIEInstance));
-					}
-				}
-			}
-		}
-		return LOCTEXT("NoWorld", "No World");
-	}
-	return SelectedWorldText;
+	// Falls back to the first available world when the selection is gone
+	const FGASWorldContextInfo* Context = SharedState.IsValid()
+		? SharedState->GetWorldService().FindWorldContext(SharedState->GetSelectedWorldContextHandle())
+		: nullptr;
+	return Context ? Context->DisplayName : LOCTEXT("NoWorld", "No World");
 }
 
 TSharedRef<SWidget> SGASDebuggerMainWindow::BuildActorSelector()
@@ -301,7 +321,15 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildActorSelector()
 
 			if (SharedState.IsValid())
 			{
-				for (const TWeakObjectPtr<UAbilitySystemComponent>& ASC : SharedState->GetCachedASCList())
+				const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& ASCList = SharedState->GetFilteredASCList();
+				if (SharedState->HasActorTagQuery())
+				{
+					MenuBuilder.BeginSection(NAME_None, FText::Format(LOCTEXT("TagQueryMatches", "Matching tag query: {0} of {1}"),
+						FText::AsNumber(ASCList.Num()), FText::AsNumber(SharedState->GetCachedASCList().Num())));
+					MenuBuilder.EndSection();
+				}
+
+				for (const TWeakObjectPtr<UAbilitySystemComponent>& ASC : ASCList)
 				{
 					if (!ASC.IsValid())
 					{
@@ -333,6 +361,35 @@ TSharedRef<SWidget> SGASDebuggerMainWindow::BuildActorSelector()
 		];
 }
 
+TSharedRef<SWidget> SGASDebuggerMainWindow::BuildTagQueryBox()
+{
+	return SNew(SBox)
+		.MinDesiredWidth(220)
+		[
+			SAssignNew(TagQueryBox, SEditableTextBox)
+			.HintText(LOCTEXT("TagQueryHint", "Tag query, e.g. State.Stunned !Immune.CC"))
+			.ToolTipText(LOCTEXT("TagQueryTooltip", "Only list actors whose owned tags contain every tag and none of the '!' prefixed tags"))
+			.OnTextCommitted(this, &SGASDebuggerMainWindow::HandleTagQueryCommitted)
+		];
+}
+
+void SGASDebuggerMainWindow::HandleTagQueryCommitted(const FText& InText, ETextCommit::Type CommitType)
+{
+	FGameplayTagQuery Query;
+	FText Error;
+	if (!FGASTagQueryIndex::ParseQueryText(InText.ToString(), Query, Error))
+	{
+		TagQueryBox->SetError(Error);
+		return;
+	}
+
+	TagQueryBox->SetError(FText::GetEmpty());
+	if (SharedState.IsValid())
+	{
+		SharedState->SetActorTagQuery(Query);
+	}
+}
+
 void SGASDebuggerMainWindow::HandleActorSelectionChanged(TWeakObjectPtr<UAbilitySystemComponent> InASC)
 {
 	if (SharedState.IsValid())
@@ -384,6 +441,116 @@ FText SGASDebuggerMainWindow::GetPickingModeText() const
 	return LOCTEXT("TickModeOff", "Tick");
 }
 
+ECheckBoxState SGASDebuggerMainWindow::GetRecordingCheckState() const
+{
+	return FGASFlightRecorder::Get().IsRecording() ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SGASDebuggerMainWindow::HandleRecordingChanged(ECheckBoxState NewState)
+{
+	FGASFlightRecorder& Recorder = FGASFlightRecorder::Get();
+	if (NewState != ECheckBoxState::Checked)
+	{
+		Recorder.Stop();
+		return;
+	}
+
+	// Records the ASCs this window shows, the recorder is shared by every window
+	if (SharedState.IsValid())
+	{
+		Recorder.Start(SharedState.ToSharedRef());
+	}
+}
+
+FText SGASDebuggerMainWindow::GetRecordingText() const
+{
+	const FGASFlightRecorder& Recorder = FGASFlightRecorder::Get();
+	if (!Recorder.IsRecording() && Recorder.GetRecordedSeconds() <= 0.0)
+	{
+		return LOCTEXT("Record", "Record");
+	}
+
+	return FText::Format(LOCTEXT("Recording", "Rec {0} | {1}"),
+		FText::AsTimespan(FTimespan::FromSeconds(Recorder.GetRecordedSeconds())),
+		FText::AsMemory(Recorder.GetAllocatedSize()));
+}
+
+FText SGASDebuggerMainWindow::GetRecordingToolTipText() const
+{
+	const FGASFlightRecorder& Recorder = FGASFlightRecorder::Get();
+	return FText::Format(LOCTEXT("RecordingTooltip", "Record the GAS state changes of the selected actor, or of every actor matching the tag query, each frame ({0} watched).\nThe recording cost shows as Rec in the overhead display and counts toward the frame budget.\nGASDebugger.Recorder.Dump writes the recording as CSV."),
+		FText::AsNumber(Recorder.GetNumWatched()));
+}
+
+FText SGASDebuggerMainWindow::GetOverheadText() const
+{
+	if (!SharedState.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	FNumberFormattingOptions NumberFormat;
+	NumberFormat.MinimumFractionalDigits = 2;
+	NumberFormat.MaximumFractionalDigits = 2;
+
+	const FGASDebuggerOverhead& Overhead = SharedState->GetOverhead();
+	return FText::Format(LOCTEXT("Overhead", "Capture {0} | Build {1} | Paint {2} | Rec {3} ms | History {4}"),
+		FText::AsNumber(Overhead.CaptureMs, &NumberFormat),
+		FText::AsNumber(Overhead.ModelBuildMs, &NumberFormat),
+		FText::AsNumber(Overhead.PaintMs, &NumberFormat),
+		FText::AsNumber(Overhead.RecordMs, &NumberFormat),
+		FText::AsMemory(Overhead.HistoryBytes));
+}
+
+FText SGASDebuggerMainWindow::GetOverheadToolTipText() const
+{
+	if (!SharedState.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	FNumberFormattingOptions NumberFormat;
+	NumberFormat.MinimumFractionalDigits = 2;
+	NumberFormat.MaximumFractionalDigits = 2;
+
+	const FText RefreshCost = FText::Format(LOCTEXT("RefreshCost", "Refresh: {0} ms ({1} ms average)"),
+		FText::AsNumber(SharedState->GetLastRefreshCostMs(), &NumberFormat),
+		FText::AsNumber(SharedState->GetAverageRefreshCostMs(), &NumberFormat));
+
+	const float BudgetMs = SharedState->GetFrameBudgetMs();
+	if (BudgetMs <= 0.f)
+	{
+		return FText::Format(LOCTEXT("OverheadTooltipNoBudget", "Smoothed cost of this debugger window\n{0}\nClick to set a frame budget"), RefreshCost);
+	}
+
+	return FText::Format(LOCTEXT("OverheadTooltipBudget", "Smoothed cost of this debugger window\n{0}\nFrame budget: {1} ms{2}"),
+		RefreshCost,
+		FText::AsNumber(BudgetMs),
+		SharedState->IsThrottled() ? LOCTEXT("Throttled", " (throttled, refreshing less often)") : FText::GetEmpty());
+}
+
+FSlateColor SGASDebuggerMainWindow::GetOverheadColor() const
+{
+	if (SharedState.IsValid() && SharedState->IsThrottled())
+	{
+		return FSlateColor(FLinearColor::Yellow);
+	}
+	return FSlateColor::UseSubduedForeground();
+}
+
+void SGASDebuggerMainWindow::HandleFrameBudgetSelected(float InBudgetMs)
+{
+	if (SharedState.IsValid())
+	{
+		SharedState->SetFrameBudgetMs(InBudgetMs);
+	}
+}
+
+bool SGASDebuggerMainWindow::IsFrameBudgetSelected(float InBudgetMs) const
+{
+	return SharedState.IsValid() && FMath::IsNearlyEqual(SharedState->GetFrameBudgetMs(), InBudgetMs);
+}
+
 FReply SGASDebuggerMainWindow::OnRefreshButtonClicked()
 {
 	if (SharedState.IsValid())
@@ -7,6 +7,7 @@
 #include "Framework/Application/IInputProcessor.h"
 
 class FGASDebuggerSharedState;
+class SEditableTextBox;
 class UAbilitySystemComponent;
 
 /**
@@ -25,12 +26,16 @@ public:
 	virtual ~SGASDebuggerMainWindow();
 
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 private:
 	// === Top Bar ===
 	TSharedRef<SWidget> BuildTopBar();
 	TSharedRef<SWidget> BuildWorldSelector();
 	TSharedRef<SWidget> BuildActorSelector();
+	TSharedRef<SWidget> BuildTagQueryBox();
+	TSharedRef<SWidget> BuildOverheadDisplay();
 
 	// === World Selection ===
 	void HandleWorldSelectionChanged(FName InContextHandle);
@@ -40,6 +45,9 @@ private:
 	void HandleActorSelectionChanged(TWeakObjectPtr<UAbilitySystemComponent> InASC);
 	FText GetActorSelectorText() const;
 
+	// === Actor Tag Query ===
+	void HandleTagQueryCommitted(const FText& InText, ETextCommit::Type CommitType);
+
 	// === Picking Mode ===
 	ECheckBoxState GetPickingModeCheckState() const;
 	void HandlePickingModeChanged(ECheckBoxState NewState);
@@ -48,6 +56,19 @@ private:
 	// === Refresh ===
 	FReply OnRefreshButtonClicked();
 
+	// === Flight Recorder ===
+	ECheckBoxState GetRecordingCheckState() const;
+	void HandleRecordingChanged(ECheckBoxState NewState);
+	FText GetRecordingText() const;
+	FText GetRecordingToolTipText() const;
+
+	// === Overhead and Frame Budget ===
+	FText GetOverheadText() const;
+	FText GetOverheadToolTipText() const;
+	FSlateColor GetOverheadColor() const;
+	void HandleFrameBudgetSelected(float InBudgetMs);
+	bool IsFrameBudgetSelected(float InBudgetMs) const;
+
 	// === New Window ===
 	FReply OnNewWindowButtonClicked();
 
@@ -57,9 +78,7 @@ private:
 private:
 	TSharedPtr<FGASDebuggerSharedState> SharedState;
 	TSharedPtr<class IInputProcessor> InputProcessor;
-
-	// Cached display text
-	FText SelectedWorldText;
+	TSharedPtr<SEditableTextBox> TagQueryBox;
 };
 
 /**
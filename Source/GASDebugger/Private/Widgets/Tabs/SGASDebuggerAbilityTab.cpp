@@ -1,7 +1,9 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/Tabs/SGASDebuggerAbilityTab.h"
+#include "Core/GASDebuggerStats.h"
 #include "Widgets/TreeNodes/GASAbilityTreeNode.h"
+#include "Core/GASSnapshotStore.h"
 #include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
@@ -117,6 +119,8 @@ void SGASDebuggerAbilityTab::Construct(const FArguments& InArgs)
 
 void SGASDebuggerAbilityTab::OnSelectionChanged()
 {
+	// Spec handles are only unique per ASC
+	AbilityNodes.Reset();
 	RefreshAbilityTree();
 }
 
@@ -127,6 +131,8 @@ void SGASDebuggerAbilityTab::OnRefreshRequested()
 
 void SGASDebuggerAbilityTab::RefreshAbilityTree()
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshAbilities);
+
 	UAbilitySystemComponent* ASC = GetASC();
 	if (!ASC || !AbilityTreeView.IsValid())
 	{
@@ -134,13 +140,40 @@ void SGASDebuggerAbilityTab::RefreshAbilityTree()
 	}
 
 	AbilityTreeRoot.Reset();
+	SeenAbilityHandles.Reset();
+	bHasCooldownAbilities = false;
+
+	// Nodes reuse their activation state until something it depends on moved
+	const FGASSnapshot& Snapshot = FGASSnapshotStore::Get().Acquire(ASC, GASDebugCategoryBit(EGASDebugCategory::Tags));
+	if (Snapshot.BlockedTags != LastBlockedTags)
+	{
+		LastBlockedTags = Snapshot.BlockedTags;
+		++BlockedTagsVersion;
+	}
+
+	FGASAbilityStateVersions Versions = SharedState->GetAbilityStateVersions();
+	Versions.BlockedTags = BlockedTagsVersion;
 
 	for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
 	{
-		TSharedRef<FGASAbilityNode> Node = FGASAbilityNode::Create(ASC, Spec);
+		SeenAbilityHandles.Add(Spec.Handle);
+
+		bool bIsNewNode = false;
+		TSharedRef<FGASAbilityNode>* ExistingNode = AbilityNodes.Find(Spec.Handle);
+		if (ExistingNode)
+		{
+			(*ExistingNode)->Update(Spec, Versions);
+		}
+		else
+		{
+			ExistingNode = &AbilityNodes.Add(Spec.Handle, FGASAbilityNode::Create(ASC, Spec, Versions));
+			bIsNewNode = true;
+		}
+		TSharedRef<FGASAbilityNode> Node = *ExistingNode;
 
 		// Apply filter
 		EGASAbilityState State = Node->GetState();
+		bHasCooldownAbilities |= (State == EGASAbilityState::Cooldown);
 		bool bShouldShow = false;
 
 		if ((AbilityFilterState & EGASAbilityFilterState::Active) && State == EGASAbilityState::Active)
@@ -162,24 +195,61 @@ void SGASDebuggerAbilityTab::RefreshAbilityTree()
 		{
 			AbilityTreeRoot.Add(Node);
 
-			if (bTreeExpanded && AbilityTreeView.IsValid())
+			if (bIsNewNode && bTreeExpanded)
 			{
 				AbilityTreeView->SetItemExpansion(Node, true);
 			}
 		}
 	}
 
+	// Drop nodes of abilities that were removed from the ASC
+	if (AbilityNodes.Num() != SeenAbilityHandles.Num())
+	{
+		for (auto It = AbilityNodes.CreateIterator(); It; ++It)
+		{
+			if (!SeenAbilityHandles.Contains(It.Key()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
 	AbilityTreeView->RequestTreeRefresh();
 }
 
+bool SGASDebuggerAbilityTab::NeedsPeriodicRefresh() const
+{
+	// Cooldown countdown text is time-dependent
+	return bHasCooldownAbilities;
+}
+
 TSharedRef<ITableRow> SGASDebuggerAbilityTab::OnGenerateRow(TSharedRef<FGASAbilityNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_GenerateRow);
+	INC_DWORD_STAT(STAT_GASDebugger_WidgetsCreated);
+
 	return SNew(SGASAbilityTreeItem, OwnerTable)
 		.NodeInfo(InItem);
 }
 
 void SGASDebuggerAbilityTab::OnGetChildren(TSharedRef<FGASAbilityNodeBase> InItem, TArray<TSharedRef<FGASAbilityNodeBase>>& OutChildren)
 {
+	// Collapsed rows only need to know whether to show an expander, children are built on expansion
+	if (!AbilityTreeView->IsItemExpanded(InItem))
+	{
+		if (InItem->MayHaveChildren())
+		{
+			if (!CollapsedChildPlaceholder.IsValid())
+			{
+				CollapsedChildPlaceholder = MakeShared<FGASAbilityPlaceholderNode>();
+			}
+			OutChildren.Add(CollapsedChildPlaceholder.ToSharedRef());
+		}
+		return;
+	}
+
+	// Rebuilt at most once per node update, however often the tree asks
+	InItem->UpdateChildren();
 	OutChildren = InItem->GetChildren();
 }
 
@@ -6,8 +6,10 @@
 #include "Widgets/Tabs/SGASDebuggerTabBase.h"
 #include "Widgets/Views/STreeView.h"
 #include "GASDebuggerTypes.h"
+#include "GameplayAbilitySpec.h"
 
 class FGASAbilityNodeBase;
+class FGASAbilityNode;
 
 /**
  * Ability tab for GASDebugger.
@@ -28,6 +30,8 @@ public:
 protected:
 	virtual void OnSelectionChanged() override;
 	virtual void OnRefreshRequested() override;
+	virtual EGASDebugCategory GetDebugCategory() const override { return EGASDebugCategory::Ability; }
+	virtual bool NeedsPeriodicRefresh() const override;
 
 private:
 	void RefreshAbilityTree();
@@ -42,6 +46,19 @@ private:
 
 	TSharedPtr<STreeView<TSharedRef<FGASAbilityNodeBase>>> AbilityTreeView;
 	TArray<TSharedRef<FGASAbilityNodeBase>> AbilityTreeRoot;
+
+	/** Nodes of the previous refresh, updated in place so rows, selection and expansion survive */
+	TMap<FGameplayAbilitySpecHandle, TSharedRef<FGASAbilityNode>> AbilityNodes;
+	TSet<FGameplayAbilitySpecHandle> SeenAbilityHandles;
+
+	/** Stands in for the children of collapsed rows so they keep their expander, never displayed */
+	TSharedPtr<FGASAbilityNodeBase> CollapsedChildPlaceholder;
+
+	/** The ASC has no event for blocked ability tags, they are compared against the previous refresh */
+	FGameplayTagContainer LastBlockedTags;
+	uint32 BlockedTagsVersion = 0;
+
 	uint8 AbilityFilterState = EGASAbilityFilterState::Active | EGASAbilityFilterState::Blocked | EGASAbilityFilterState::Inactive;
 	bool bTreeExpanded = false;
+	bool bHasCooldownAbilities = false;
 };
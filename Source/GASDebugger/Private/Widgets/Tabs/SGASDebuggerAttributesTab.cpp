@@ -1,12 +1,16 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/Tabs/SGASDebuggerAttributesTab.h"
+#include "Core/GASDebuggerStats.h"
 #include "Widgets/TreeNodes/GASAttributeTreeNode.h"
+#include "Core/GASAttributeModel.h"
+#include "Core/GASSnapshotStore.h"
 #include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Input/SSearchBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "AbilitySystemComponent.h"
-#include "AttributeSet.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
 #define LOCTEXT_NAMESPACE "SGASDebuggerAttributesTab"
 
@@ -66,6 +70,9 @@ void SGASDebuggerAttributesTab::Construct(const FArguments& InArgs)
 
 void SGASDebuggerAttributesTab::OnSelectionChanged()
 {
+	// Models still in flight belong to the previous ASC
+	++ModelGeneration;
+	AttributeNodes.Reset();
 	RefreshAttributeTree();
 }
 
@@ -76,49 +83,100 @@ void SGASDebuggerAttributesTab::OnRefreshRequested()
 
 void SGASDebuggerAttributesTab::RefreshAttributeTree()
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshAttributes);
+
 	UAbilitySystemComponent* ASC = GetASC();
 	if (!ASC || !AttributeTreeView.IsValid())
 	{
 		return;
 	}
 
-	AttributeTreeRoot.Reset();
+	if (bModelBuildInFlight)
+	{
+		// Capture again once the running build lands, so the tree never lags more than one build
+		bModelRebuildPending = true;
+		return;
+	}
 
-	for (UAttributeSet* Set : ASC->GetSpawnedAttributes())
+	// Game thread part: copy raw values only, nothing is formatted or filtered here
+	const FGASSnapshot& Snapshot = FGASSnapshotStore::Get().Acquire(ASC, GASDebugCategoryBit(EGASDebugCategory::Attributes));
+	TSharedRef<FGASAttributeCapture> Capture = MakeShared<FGASAttributeCapture>();
+	Capture->Attributes = Snapshot.Attributes;
+	Capture->Modifiers = Snapshot.Modifiers;
+	Capture->SearchText = SearchText;
+	INC_DWORD_STAT_BY(STAT_GASDebugger_BytesAllocated, sizeof(FGASAttributeCapture)
+		+ Capture->Attributes.GetAllocatedSize() + Capture->Modifiers.Modifiers.GetAllocatedSize());
+
+	const uint32 Generation = ModelGeneration;
+	const uint32 Serial = ++CaptureSerial;
+	bModelBuildInFlight = true;
+	TWeakPtr<SGASDebuggerAttributesTab> WeakTab = StaticCastSharedRef<SGASDebuggerAttributesTab>(AsShared());
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Capture, Generation, Serial, WeakTab]()
 	{
-		if (!Set)
+		TSharedRef<FGASAttributeModel> Model = MakeShared<FGASAttributeModel>();
+		FGASAttributeModel::Build(*Capture, *Model);
+
+		// Slate widgets and nodes are only touched on the game thread
+		AsyncTask(ENamedThreads::GameThread, [Model, Generation, Serial, WeakTab]()
 		{
-			continue;
+			if (TSharedPtr<SGASDebuggerAttributesTab> Tab = WeakTab.Pin())
+			{
+				Tab->ApplyAttributeModel(*Model, Generation, Serial);
+			}
+		});
+	});
+}
+
+void SGASDebuggerAttributesTab::ApplyAttributeModel(const FGASAttributeModel& Model, uint32 Generation, uint32 Serial)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_ApplyAttributeModel);
+
+	bModelBuildInFlight = false;
+
+	if (Generation == ModelGeneration && Serial > AppliedCaptureSerial && AttributeTreeView.IsValid())
+	{
+		AppliedCaptureSerial = Serial;
+		ReconcileAttributeNodes(Model);
+	}
+
+	if (bModelRebuildPending)
+	{
+		bModelRebuildPending = false;
+		RefreshAttributeTree();
+	}
+}
+
+void SGASDebuggerAttributesTab::ReconcileAttributeNodes(const FGASAttributeModel& Model)
+{
+	AttributeTreeRoot.Reset(Model.Rows.Num());
+	SeenAttributes.Reset();
+
+	for (const FGASAttributeRow& Row : Model.Rows)
+	{
+		SeenAttributes.Add(Row.Info.Attribute);
+
+		TSharedRef<FGASAttributeNode>* Node = AttributeNodes.Find(Row.Info.Attribute);
+		if (Node)
+		{
+			(*Node)->Update(Row);
+		}
+		else
+		{
+			Node = &AttributeNodes.Add(Row.Info.Attribute, FGASAttributeNode::Create(Row));
 		}
 
-		FName SetName = Set->GetClass()->GetFName();
+		AttributeTreeRoot.Add(*Node);
+	}
 
-		for (TFieldIterator<FProperty> It(Set->GetClass()); It; ++It)
+	// Drop nodes of attributes that are gone or filtered out
+	if (AttributeNodes.Num() != SeenAttributes.Num())
+	{
+		for (auto It = AttributeNodes.CreateIterator(); It; ++It)
 		{
-			FProperty* Property = *It;
-			if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+			if (!SeenAttributes.Contains(It.Key()))
 			{
-				if (StructProp->Struct == FGameplayAttributeData::StaticStruct())
-				{
-					// Apply search filter
-					FString AttributeName = Property->GetName();
-					if (!PassesFilter(AttributeName))
-					{
-						continue;
-					}
-
-					FGameplayAttributeData* DataPtr = StructProp->ContainerPtrToValuePtr<FGameplayAttributeData>(Set);
-					if (DataPtr)
-					{
-						FGASAttributeInfo Info;
-						Info.Attribute = FGameplayAttribute(Property);
-						Info.BaseValue = DataPtr->GetBaseValue();
-						Info.CurrentValue = DataPtr->GetCurrentValue();
-						Info.AttributeSetName = SetName;
-
-						AttributeTreeRoot.Add(FGASAttributeNode::Create(Info));
-					}
-				}
+				It.RemoveCurrent();
 			}
 		}
 	}
@@ -128,6 +186,9 @@ void SGASDebuggerAttributesTab::RefreshAttributeTree()
 
 TSharedRef<ITableRow> SGASDebuggerAttributesTab::OnGenerateRow(TSharedRef<FGASAttributeNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_GenerateRow);
+	INC_DWORD_STAT(STAT_GASDebugger_WidgetsCreated);
+
 	return SNew(SGASAttributeTreeItem, OwnerTable)
 		.NodeInfo(InItem);
 }
@@ -143,15 +204,4 @@ void SGASDebuggerAttributesTab::OnSearchTextChanged(const FText& InText)
 	RefreshAttributeTree();
 }
 
-bool SGASDebuggerAttributesTab::PassesFilter(const FString& AttributeName) const
-{
-	if (SearchText.IsEmpty())
-	{
-		return true;
-	}
-
-	// Case-insensitive fuzzy search
-	return AttributeName.Contains(SearchText, ESearchCase::IgnoreCase);
-}
-
 #undef LOCTEXT_NAMESPACE
@@ -5,12 +5,17 @@
 #include "CoreMinimal.h"
 #include "Widgets/Tabs/SGASDebuggerTabBase.h"
 #include "Widgets/Views/STreeView.h"
+#include "GASDebuggerTypes.h"
 
 class FGASAttributeNodeBase;
+class FGASAttributeNode;
+struct FGASAttributeModel;
 
 /**
  * Attributes tab for GASDebugger.
  * Displays attribute sets and their values in a tree view.
+ * Each attribute lists the active effect modifiers affecting it as children.
+ * Values are captured on the game thread, filtering and formatting run on a worker task.
  */
 class SGASDebuggerAttributesTab : public SGASDebuggerTabBase
 {
@@ -24,18 +29,44 @@ public:
 	static FName GetTabId() { return FName("GASDebugger_Attributes"); }
 	static FText GetTabLabel();
 
+	/** True from a capture until its model is applied, or a re-run of it is launched */
+	bool IsModelBuildInFlight() const { return bModelBuildInFlight; }
+
 protected:
 	virtual void OnSelectionChanged() override;
 	virtual void OnRefreshRequested() override;
+	virtual EGASDebugCategory GetDebugCategory() const override { return EGASDebugCategory::Attributes; }
 
 private:
+	/** Capture the ASC on the game thread and launch the model build */
 	void RefreshAttributeTree();
+
+	/** Reconcile the tree nodes with a finished model, models of an older selection or capture are dropped */
+	void ApplyAttributeModel(const FGASAttributeModel& Model, uint32 Generation, uint32 Serial);
+
+	/** Update the tree nodes in place from a model of the current selection */
+	void ReconcileAttributeNodes(const FGASAttributeModel& Model);
+
 	TSharedRef<ITableRow> OnGenerateRow(TSharedRef<FGASAttributeNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable);
 	void OnGetChildren(TSharedRef<FGASAttributeNodeBase> InItem, TArray<TSharedRef<FGASAttributeNodeBase>>& OutChildren);
 	void OnSearchTextChanged(const FText& InText);
-	bool PassesFilter(const FString& AttributeName) const;
 
 	TSharedPtr<STreeView<TSharedRef<FGASAttributeNodeBase>>> AttributeTreeView;
 	TArray<TSharedRef<FGASAttributeNodeBase>> AttributeTreeRoot;
+
+	/** Nodes of the previous refresh, updated in place so expanded modifier lists survive */
+	TMap<FGameplayAttribute, TSharedRef<FGASAttributeNode>> AttributeNodes;
+	TSet<FGameplayAttribute> SeenAttributes;
+
+	/** Bumped when the selection changes, models captured from the previous ASC are dropped */
+	uint32 ModelGeneration = 0;
+
+	/** Serial of the last launched capture and of the last applied model */
+	uint32 CaptureSerial = 0;
+	uint32 AppliedCaptureSerial = 0;
+
+	/** Only one model build runs at a time, refreshes that arrive meanwhile re-run it once it lands */
+	bool bModelBuildInFlight = false;
+	bool bModelRebuildPending = false;
 	FString SearchText;
 };
@@ -1,7 +1,9 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/Tabs/SGASDebuggerEffectsTab.h"
+#include "Core/GASDebuggerStats.h"
 #include "Widgets/TreeNodes/GASEffectTreeNode.h"
+#include "Core/GASSnapshotStore.h"
 #include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/SBoxPanel.h"
@@ -88,19 +90,9 @@ void SGASDebuggerEffectsTab::Construct(const FArguments& InArgs)
 	RefreshEffectTree();
 }
 
-void SGASDebuggerEffectsTab::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
-{
-	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
-
-	// Always refresh to update progress bars in real-time
-	if (SharedState.IsValid() && SharedState->IsPickingMode())
-	{
-		RefreshEffectTree();
-	}
-}
-
 void SGASDebuggerEffectsTab::OnSelectionChanged()
 {
+	EffectNodes.Reset();
 	RefreshEffectTree();
 }
 
@@ -111,6 +103,8 @@ void SGASDebuggerEffectsTab::OnRefreshRequested()
 
 void SGASDebuggerEffectsTab::RefreshEffectTree()
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshEffects);
+
 	UAbilitySystemComponent* ASC = GetASC();
 	UWorld* World = GetWorld();
 	if (!ASC || !EffectTreeView.IsValid() || !World)
@@ -119,15 +113,40 @@ void SGASDebuggerEffectsTab::RefreshEffectTree()
 	}
 
 	EffectTreeRoot.Reset();
+	SeenEffectHandles.Reset();
 
-	const FActiveGameplayEffectsContainer& ActiveEffects = ASC->GetActiveGameplayEffects();
-	for (const FActiveGameplayEffect& ActiveGE : &ActiveEffects)
+	// Shared with every other window watching this ASC, read once per frame
+	const FGASSnapshot& Snapshot = FGASSnapshotStore::Get().Acquire(ASC, GASDebugCategoryBit(EGASDebugCategory::GameplayEffects));
+	for (const FGASEffectSnapshot& Effect : Snapshot.Effects)
 	{
-		EffectTreeRoot.Add(FGASEffectNode::Create(World, ActiveGE));
+		SeenEffectHandles.Add(Effect.Handle);
+
+		if (TSharedRef<FGASEffectNode>* ExistingNode = EffectNodes.Find(Effect.Handle))
+		{
+			(*ExistingNode)->Update(World, Effect);
+			EffectTreeRoot.Add(*ExistingNode);
+			continue;
+		}
+
+		TSharedRef<FGASEffectNode> Node = FGASEffectNode::Create(World, Effect);
+		EffectNodes.Add(Effect.Handle, Node);
+		EffectTreeRoot.Add(Node);
+
+		if (bTreeExpanded)
+		{
+			EffectTreeView->SetItemExpansion(Node, true);
+		}
+	}
 
-		if (bTreeExpanded && EffectTreeView.IsValid())
+	// Every live effect is in the root, so any extra node belongs to a removed effect
+	if (EffectNodes.Num() != EffectTreeRoot.Num())
+	{
+		for (auto It = EffectNodes.CreateIterator(); It; ++It)
 		{
-			EffectTreeView->SetItemExpansion(EffectTreeRoot.Last(), true);
+			if (!SeenEffectHandles.Contains(It.Key()))
+			{
+				It.RemoveCurrent();
+			}
 		}
 	}
 
@@ -136,12 +155,31 @@ void SGASDebuggerEffectsTab::RefreshEffectTree()
 
 TSharedRef<ITableRow> SGASDebuggerEffectsTab::OnGenerateRow(TSharedRef<FGASEffectNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_GenerateRow);
+	INC_DWORD_STAT(STAT_GASDebugger_WidgetsCreated);
+
 	return SNew(SGASEffectTreeItem, OwnerTable)
 		.NodeInfo(InItem);
 }
 
 void SGASDebuggerEffectsTab::OnGetChildren(TSharedRef<FGASEffectNodeBase> InItem, TArray<TSharedRef<FGASEffectNodeBase>>& OutChildren)
 {
+	// Collapsed rows only need to know whether to show an expander, children are built on expansion
+	if (!EffectTreeView->IsItemExpanded(InItem))
+	{
+		if (InItem->MayHaveChildren())
+		{
+			if (!CollapsedChildPlaceholder.IsValid())
+			{
+				CollapsedChildPlaceholder = FGASEffectNode::Create(nullptr, FGASEffectSnapshot());
+			}
+			OutChildren.Add(CollapsedChildPlaceholder.ToSharedRef());
+		}
+		return;
+	}
+
+	// Rebuilt at most once per node update, however often the tree asks
+	InItem->UpdateChildren();
 	OutChildren = InItem->GetChildren();
 }
 
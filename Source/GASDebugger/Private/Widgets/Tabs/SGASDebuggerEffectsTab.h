@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "Widgets/Tabs/SGASDebuggerTabBase.h"
 #include "Widgets/Views/STreeView.h"
+#include "ActiveGameplayEffectHandle.h"
 
 class FGASEffectNodeBase;
+class FGASEffectNode;
 
 /**
  * GameplayEffects tab for GASDebugger.
  * Displays active gameplay effects with progress bars for duration.
+ * Progress bars and remaining time are bound to the nodes, so they update without rebuilding the tree.
  */
 class SGASDebuggerEffectsTab : public SGASDebuggerTabBase
 {
@@ -20,7 +23,6 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
-	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 	static FName GetTabId() { return FName("GASDebugger_Effects"); }
 	static FText GetTabLabel();
@@ -28,6 +30,7 @@ public:
 protected:
 	virtual void OnSelectionChanged() override;
 	virtual void OnRefreshRequested() override;
+	virtual EGASDebugCategory GetDebugCategory() const override { return EGASDebugCategory::GameplayEffects; }
 
 private:
 	void RefreshEffectTree();
@@ -39,5 +42,13 @@ private:
 
 	TSharedPtr<STreeView<TSharedRef<FGASEffectNodeBase>>> EffectTreeView;
 	TArray<TSharedRef<FGASEffectNodeBase>> EffectTreeRoot;
+
+	/** Nodes of the previous refresh, updated in place so rows, selection and expansion survive */
+	TMap<FActiveGameplayEffectHandle, TSharedRef<FGASEffectNode>> EffectNodes;
+	TSet<FActiveGameplayEffectHandle> SeenEffectHandles;
+
+	/** Stands in for the children of collapsed rows so they keep their expander, never displayed */
+	TSharedPtr<FGASEffectNodeBase> CollapsedChildPlaceholder;
+
 	bool bTreeExpanded = false;
 };
@@ -2,6 +2,7 @@
 
 #include "Widgets/Tabs/SGASDebuggerTabBase.h"
 #include "AbilitySystemComponent.h"
+#include "HAL/PlatformTime.h"
 
 SGASDebuggerTabBase::~SGASDebuggerTabBase()
 {
@@ -33,7 +34,7 @@ void SGASDebuggerTabBase::SubscribeToSharedState()
 		SelectionChangedHandle = SharedState->OnSelectionChanged.AddSP(
 			this, &SGASDebuggerTabBase::OnSelectionChanged);
 		RefreshRequestedHandle = SharedState->OnRefreshRequested.AddSP(
-			this, &SGASDebuggerTabBase::OnRefreshRequested);
+			this, &SGASDebuggerTabBase::HandleRefreshRequested);
 	}
 }
 
@@ -45,3 +46,29 @@ void SGASDebuggerTabBase::UnsubscribeFromSharedState()
 		SharedState->OnRefreshRequested.Remove(RefreshRequestedHandle);
 	}
 }
+
+void SGASDebuggerTabBase::HandleRefreshRequested(uint8 DirtyCategories)
+{
+	if ((DirtyCategories & GASDebugCategoryBit(GetDebugCategory())) != 0 || NeedsPeriodicRefresh())
+	{
+		// The pass is over the frame budget, the category stays dirty for the next one
+		if (SharedState->ShouldDeferRefresh(GetDebugCategory()))
+		{
+			return;
+		}
+		OnRefreshRequested();
+	}
+}
+
+int32 SGASDebuggerTabBase::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 MaxLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	if (SharedState.IsValid())
+	{
+		SharedState->AddPaintCost(FPlatformTime::Seconds() - StartTime);
+	}
+	return MaxLayerId;
+}
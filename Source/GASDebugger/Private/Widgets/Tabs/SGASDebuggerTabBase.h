@@ -21,13 +21,23 @@ public:
 
 	virtual ~SGASDebuggerTabBase();
 
+	// SWidget interface, the paint time is reported to the shared state's overhead display
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
 protected:
 	/** Called when World or Actor selection changes */
 	virtual void OnSelectionChanged() {}
 
-	/** Called when refresh is explicitly requested */
+	/** Called by a refresh pass when this tab's category is dirty (or NeedsPeriodicRefresh) */
 	virtual void OnRefreshRequested() {}
 
+	/** GAS data category displayed by this tab, used to skip refreshes while it is clean */
+	virtual EGASDebugCategory GetDebugCategory() const = 0;
+
+	/** Return true while the tab shows time-dependent data that must refresh even when clean */
+	virtual bool NeedsPeriodicRefresh() const { return false; }
+
 	/** Get the currently selected ASC */
 	UAbilitySystemComponent* GetASC() const;
 
@@ -40,6 +50,9 @@ protected:
 	/** Unsubscribe from shared state delegates */
 	void UnsubscribeFromSharedState();
 
+	/** Filter refresh passes by dirty category */
+	void HandleRefreshRequested(uint8 DirtyCategories);
+
 	TSharedPtr<FGASDebuggerSharedState> SharedState;
 	FDelegateHandle SelectionChangedHandle;
 	FDelegateHandle RefreshRequestedHandle;
@@ -1,13 +1,17 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/Tabs/SGASDebuggerTagsTab.h"
+#include "Core/GASDebuggerStats.h"
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Layout/SBorder.h"
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/SBoxPanel.h"
+#include "Core/GASDataProvider.h"
+#include "Core/GASSnapshotStore.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
 
 #define LOCTEXT_NAMESPACE "SGASDebuggerTagsTab"
 
@@ -21,77 +25,101 @@ void SGASDebuggerTagsTab::Construct(const FArguments& InArgs)
 	SharedState = InArgs._SharedState;
 	SubscribeToSharedState();
 
+	OwnedTags.Color = FLinearColor(0.1f, 0.4f, 0.1f, 1.f);
+	BlockedTags.Color = FLinearColor(0.4f, 0.1f, 0.1f, 1.f);
+
 	ChildSlot
 	[
-		SNew(SSplitter)
-		.Orientation(Orient_Vertical)
-		+ SSplitter::Slot()
-		.Value(0.7f)
+		SNew(SVerticalBox)
+
+		// Search box
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.f)
 		[
-			SNew(SVerticalBox)
+			SNew(SSearchBox)
+			.HintText(LOCTEXT("SearchHint", "Search tags..."))
+			.OnTextChanged(this, &SGASDebuggerTagsTab::OnSearchTextChanged)
+		]
 
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			.HAlign(HAlign_Left)
-			.Padding(2.f)
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			.Value(0.7f)
 			[
-				SNew(STextBlock)
-				.Text(LOCTEXT("OwnedTags", "Owned Tags"))
+				CreateTagPanel(OwnedTags, LOCTEXT("OwnedTags", "Owned Tags"))
 			]
 
-			+ SVerticalBox::Slot()
-			.FillHeight(1.f)
+			+ SSplitter::Slot()
+			.Value(0.3f)
 			[
-				SNew(SBorder)
-				.Padding(2.f)
-				[
-					SNew(SScrollBox)
-					+ SScrollBox::Slot()
-					[
-						SAssignNew(OwnedTagsBox, SVerticalBox)
-					]
-				]
+				CreateTagPanel(BlockedTags, LOCTEXT("BlockedTags", "Blocked Tags"))
 			]
 		]
+	];
+
+	RefreshTagDisplay();
+}
+
+TSharedRef<SWidget> SGASDebuggerTagsTab::CreateTagPanel(FTagPanel& Panel, const FText& Label)
+{
+	return SNew(SVerticalBox)
 
-		+ SSplitter::Slot()
-		.Value(0.3f)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Left)
+		.Padding(2.f)
 		[
-			SNew(SVerticalBox)
+			SNew(STextBlock)
+			.Text(Label)
+		]
 
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			.HAlign(HAlign_Left)
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
 			.Padding(2.f)
 			[
-				SNew(STextBlock)
-				.Text(LOCTEXT("BlockedTags", "Blocked Tags"))
+				SAssignNew(Panel.TreeView, STreeView<TSharedRef<FGASTagNodeBase>>)
+				.TreeItemsSource(&Panel.RootItems)
+				.OnGenerateRow(this, &SGASDebuggerTagsTab::OnGenerateTagRow, Panel.Color)
+				.OnGetChildren(this, &SGASDebuggerTagsTab::OnGetTagChildren)
+				.SelectionMode(ESelectionMode::Single)
 			]
+		];
+}
 
-			+ SVerticalBox::Slot()
-			.FillHeight(1.f)
-			[
-				SNew(SBorder)
-				.Padding(2.f)
-				[
-					SNew(SScrollBox)
-					+ SScrollBox::Slot()
-					[
-						SAssignNew(BlockedTagsBox, SVerticalBox)
-					]
-				]
-			]
-		]
-	];
+TSharedRef<ITableRow> SGASDebuggerTagsTab::OnGenerateTagRow(TSharedRef<FGASTagNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable, FLinearColor Color)
+{
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_GenerateRow);
+	INC_DWORD_STAT(STAT_GASDebugger_WidgetsCreated);
 
-	RefreshTagDisplay();
+	return SNew(SGASTagTreeItem, OwnerTable)
+		.NodeInfo(InItem)
+		.TagColor(Color)
+		.HighlightText(this, &SGASDebuggerTagsTab::GetHighlightText);
+}
+
+void SGASDebuggerTagsTab::OnGetTagChildren(TSharedRef<FGASTagNodeBase> InItem, TArray<TSharedRef<FGASTagNodeBase>>& OutChildren)
+{
+	OutChildren = InItem->GetFilteredChildren();
+}
+
+void SGASDebuggerTagsTab::OnSearchTextChanged(const FText& InText)
+{
+	SearchText = InText;
+	ApplyFilter(OwnedTags);
+	ApplyFilter(BlockedTags);
 }
 
 void SGASDebuggerTagsTab::OnSelectionChanged()
 {
-	// Clear cache when selection changes to force rebuild
-	CachedOwnedTags.Reset();
-	CachedBlockedTags.Reset();
+	// Drop the nodes of the previous target so the new one is listed from scratch
+	ResetTagPanel(OwnedTags);
+	ResetTagPanel(BlockedTags);
 	RefreshTagDisplay();
 }
 
@@ -102,81 +130,117 @@ void SGASDebuggerTagsTab::OnRefreshRequested()
 
 void SGASDebuggerTagsTab::RefreshTagDisplay()
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_RefreshTags);
+
 	UAbilitySystemComponent* ASC = GetASC();
-	if (!ASC || !OwnedTagsBox.IsValid() || !BlockedTagsBox.IsValid())
+	if (!ASC || !OwnedTags.TreeView.IsValid() || !BlockedTags.TreeView.IsValid())
+	{
+		return;
+	}
+
+	// Shared with every other window watching this ASC, read once per frame
+	const FGASSnapshot& Snapshot = FGASSnapshotStore::Get().Acquire(ASC, GASDebugCategoryBit(EGASDebugCategory::Tags));
+	UpdateTagPanel(OwnedTags, Snapshot.OwnedTags);
+	UpdateTagPanel(BlockedTags, Snapshot.BlockedTags);
+}
+
+void SGASDebuggerTagsTab::UpdateTagPanel(FTagPanel& Panel, const FGameplayTagContainer& CurrentTags)
+{
+	FGASDataProvider::CaptureTagSnapshot(CurrentTags, Panel.NextSnapshot);
+	if (!FGASDataProvider::DiffTagSnapshots(Panel.Snapshot, Panel.NextSnapshot, Panel.AddedTags, Panel.RemovedTags))
+	{
+		// The tag dictionary changed, existing nodes cannot be matched by net index, list the tags from scratch
+		ResetTagPanel(Panel);
+		Panel.Snapshot.RankVersion = Panel.NextSnapshot.RankVersion;
+		FGASDataProvider::DiffTagSnapshots(Panel.Snapshot, Panel.NextSnapshot, Panel.AddedTags, Panel.RemovedTags);
+	}
+	Swap(Panel.Snapshot, Panel.NextSnapshot);
+
+	// Only touch the tree if tags have changed
+	if (Panel.AddedTags.Num() == 0 && Panel.RemovedTags.Num() == 0)
 	{
 		return;
 	}
 
-	// Get current tags
-	FGameplayTagContainer CurrentOwnedTags;
-	ASC->GetOwnedGameplayTags(CurrentOwnedTags);
+	// The first fill of a target is not a change worth highlighting
+	const bool bHighlightChanges = Panel.bHasSnapshot;
+	Panel.bHasSnapshot = true;
 
-	FGameplayTagContainer CurrentBlockedTags;
-	ASC->GetBlockedAbilityTags(CurrentBlockedTags);
+	TArray<TSharedRef<FGASTagNodeBase>> NewNodes;
 
-	// Only rebuild if tags have changed
-	bool bOwnedTagsChanged = (CurrentOwnedTags != CachedOwnedTags);
-	bool bBlockedTagsChanged = (CurrentBlockedTags != CachedBlockedTags);
+	// Markers only show the latest change, tags shown as removed leave the tree now
+	for (const TSharedRef<FGASTagNode>& Node : Panel.ChangedNodes)
+	{
+		Node->SetChange(EGASTagChange::None);
+	}
+	Panel.ChangedNodes.Reset();
 
-	if (bOwnedTagsChanged)
+	for (const FGameplayTag& GameplayTag : Panel.PendingRemovals)
 	{
-		CachedOwnedTags = CurrentOwnedTags;
-		OwnedTagsBox->ClearChildren();
+		Panel.Tree.RemoveTag(GameplayTag, NewNodes);
+	}
+	Panel.PendingRemovals.Reset();
 
-		// Sort tags alphabetically
-		TArray<FGameplayTag> SortedOwnedTags;
-		CurrentOwnedTags.GetGameplayTagArray(SortedOwnedTags);
-		SortedOwnedTags.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+	for (const uint16 NetIndex : Panel.RemovedTags)
+	{
+		const FGameplayTag& GameplayTag = TagsManager.GetTagFromNetIndex(NetIndex);
+		if (!bHighlightChanges)
+		{
+			Panel.Tree.RemoveTag(GameplayTag, NewNodes);
+		}
+		else if (TSharedPtr<FGASTagNode> Node = Panel.Tree.FindTag(GameplayTag))
 		{
-			return A.ToString() < B.ToString();
-		});
+			Node->SetChange(EGASTagChange::Removed);
+			Panel.ChangedNodes.Add(Node.ToSharedRef());
+			Panel.PendingRemovals.Add(GameplayTag);
+		}
+	}
 
-		for (const FGameplayTag& GameplayTag : SortedOwnedTags)
+	for (const uint16 NetIndex : Panel.AddedTags)
+	{
+		TSharedPtr<FGASTagNode> Node = Panel.Tree.AddTag(TagsManager.GetTagFromNetIndex(NetIndex), NewNodes);
+		if (Node.IsValid() && bHighlightChanges)
 		{
-			OwnedTagsBox->AddSlot()
-			.AutoHeight()
-			.Padding(2.f)
-			[
-				SNew(SBorder)
-				.Padding(FMargin(4.f, 2.f))
-				.BorderBackgroundColor(FSlateColor(FLinearColor(0.1f, 0.4f, 0.1f, 1.f)))
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(GameplayTag.ToString()))
-				]
-			];
+			Node->SetChange(EGASTagChange::Added);
+			Panel.ChangedNodes.Add(Node.ToSharedRef());
 		}
 	}
 
-	if (bBlockedTagsChanged)
+	ApplyFilter(Panel);
+
+	for (const TSharedRef<FGASTagNodeBase>& Node : NewNodes)
 	{
-		CachedBlockedTags = CurrentBlockedTags;
-		BlockedTagsBox->ClearChildren();
+		Panel.TreeView->SetItemExpansion(Node, true);
+	}
+}
 
-		// Sort tags alphabetically
-		TArray<FGameplayTag> SortedBlockedTags;
-		CurrentBlockedTags.GetGameplayTagArray(SortedBlockedTags);
-		SortedBlockedTags.Sort([](const FGameplayTag& A, const FGameplayTag& B)
-		{
-			return A.ToString() < B.ToString();
-		});
+void SGASDebuggerTagsTab::ApplyFilter(FTagPanel& Panel)
+{
+	Panel.Tree.ApplyFilter(SearchText.ToString());
+	Panel.RootItems = Panel.Tree.GetFilteredRootNodes();
 
-		for (const FGameplayTag& GameplayTag : SortedBlockedTags)
-		{
-			BlockedTagsBox->AddSlot()
-			.AutoHeight()
-			.Padding(2.f)
-			[
-				SNew(SBorder)
-				.Padding(FMargin(4.f, 2.f))
-				.BorderBackgroundColor(FSlateColor(FLinearColor(0.4f, 0.1f, 0.1f, 1.f)))
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(GameplayTag.ToString()))
-				]
-			];
-		}
+	// Rows of kept nodes are reused, only rows of new visible nodes are generated
+	if (Panel.TreeView.IsValid())
+	{
+		Panel.TreeView->RequestTreeRefresh();
+	}
+}
+
+void SGASDebuggerTagsTab::ResetTagPanel(FTagPanel& Panel)
+{
+	Panel.Tree.Reset();
+	Panel.Snapshot.Reset();
+	Panel.bHasSnapshot = false;
+	Panel.ChangedNodes.Reset();
+	Panel.PendingRemovals.Reset();
+	Panel.RootItems.Reset();
+
+	if (Panel.TreeView.IsValid())
+	{
+		Panel.TreeView->ClearExpandedItems();
+		Panel.TreeView->RequestTreeRefresh();
 	}
 }
 
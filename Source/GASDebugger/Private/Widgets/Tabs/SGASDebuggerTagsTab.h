@@ -4,13 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/Tabs/SGASDebuggerTabBase.h"
+#include "Widgets/Views/STreeView.h"
+#include "Widgets/TreeNodes/GASTagTreeNode.h"
 #include "GameplayTagContainer.h"
+#include "GASDebuggerTypes.h"
 
-class SVerticalBox;
+class ITableRow;
+class STableViewBase;
 
 /**
  * Tags tab for GASDebugger.
- * Displays Owned Tags and Blocked Tags with a draggable splitter.
+ * Displays Owned Tags and Blocked Tags as hierarchical trees with a draggable splitter.
  */
 class SGASDebuggerTagsTab : public SGASDebuggerTabBase
 {
@@ -27,14 +31,51 @@ public:
 protected:
 	virtual void OnSelectionChanged() override;
 	virtual void OnRefreshRequested() override;
+	virtual EGASDebugCategory GetDebugCategory() const override { return EGASDebugCategory::Tags; }
 
 private:
+	/** Virtualized tree of one tag container, nodes persist across refreshes */
+	struct FTagPanel
+	{
+		TSharedPtr<STreeView<TSharedRef<FGASTagNodeBase>>> TreeView;
+		FGASTagTree Tree;
+
+		/** Top level nodes that passed the filter */
+		TArray<TSharedRef<FGASTagNodeBase>> RootItems;
+
+		/** Tags of the last update, and the scratch snapshot swapped with it */
+		FGASTagSnapshot Snapshot;
+		FGASTagSnapshot NextSnapshot;
+		bool bHasSnapshot = false;
+
+		/** Net indices from the last diff, kept to reuse their storage */
+		TArray<uint16> AddedTags;
+		TArray<uint16> RemovedTags;
+
+		/** Nodes highlighted for the last change, removed tags stay in the tree until the next one */
+		TArray<TSharedRef<FGASTagNode>> ChangedNodes;
+		TArray<FGameplayTag> PendingRemovals;
+
+		FLinearColor Color;
+	};
+
+	TSharedRef<SWidget> CreateTagPanel(FTagPanel& Panel, const FText& Label);
+	TSharedRef<ITableRow> OnGenerateTagRow(TSharedRef<FGASTagNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable, FLinearColor Color);
+	void OnGetTagChildren(TSharedRef<FGASTagNodeBase> InItem, TArray<TSharedRef<FGASTagNodeBase>>& OutChildren);
+	void OnSearchTextChanged(const FText& InText);
+	FText GetHighlightText() const { return SearchText; }
+
 	void RefreshTagDisplay();
 
-	TSharedPtr<SVerticalBox> OwnedTagsBox;
-	TSharedPtr<SVerticalBox> BlockedTagsBox;
+	/** Diff against the last snapshot, then insert and remove the tags that changed */
+	void UpdateTagPanel(FTagPanel& Panel, const FGameplayTagContainer& CurrentTags);
+
+	/** Rebuild the filtered view of a panel */
+	void ApplyFilter(FTagPanel& Panel);
+
+	void ResetTagPanel(FTagPanel& Panel);
 
-	// Cached tags to avoid unnecessary UI rebuilds
-	FGameplayTagContainer CachedOwnedTags;
-	FGameplayTagContainer CachedBlockedTags;
+	FTagPanel OwnedTags;
+	FTagPanel BlockedTags;
+	FText SearchText;
 };
@@ -1,9 +1,12 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/TreeNodes/GASAbilityTreeNode.h"
+#include "Core/GASDebuggerStats.h"
+#include "Core/GASReflectionCache.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
 #include "GameplayEffect.h"
+#include "Engine/World.h"
 #include "SlateOptMacros.h"
 #include "Widgets/Input/SHyperlink.h"
 #include "Widgets/Text/STextBlock.h"
@@ -32,9 +35,11 @@ void FGASAbilityNodeBase::AddChildNode(TSharedRef<FGASAbilityNodeBase> InChild)
 
 TSharedRef<FGASAbilityNode> FGASAbilityNode::Create(
 	TWeakObjectPtr<UAbilitySystemComponent> InASC,
-	const FGameplayAbilitySpec& InSpec)
+	const FGameplayAbilitySpec& InSpec,
+	const FGASAbilityStateVersions& InVersions)
 {
-	return MakeShareable(new FGASAbilityNode(InASC, InSpec));
+	GASDEBUGGER_COUNT_NODE(FGASAbilityNode);
+	return MakeShareable(new FGASAbilityNode(InASC, InSpec, InVersions));
 }
 
 TSharedRef<FGASAbilityNode> FGASAbilityNode::CreateTask(
@@ -42,18 +47,20 @@ TSharedRef<FGASAbilityNode> FGASAbilityNode::CreateTask(
 	const FGameplayAbilitySpec& InSpec,
 	TWeakObjectPtr<UGameplayTask> InTask)
 {
+	GASDEBUGGER_COUNT_NODE(FGASAbilityNode);
 	return MakeShareable(new FGASAbilityNode(InASC, InSpec, InTask));
 }
 
 FGASAbilityNode::FGASAbilityNode(
 	TWeakObjectPtr<UAbilitySystemComponent> InASC,
-	const FGameplayAbilitySpec& InSpec)
+	const FGameplayAbilitySpec& InSpec,
+	const FGASAbilityStateVersions& InVersions)
 	: ASC(InASC)
 	, AbilitySpec(InSpec)
 	, NodeType(EGASAbilityNodeType::Ability)
 {
-	UpdateCache();
-	PopulateChildren();
+	CacheAbilityInfo();
+	UpdateCache(InVersions);
 }
 
 FGASAbilityNode::FGASAbilityNode(
@@ -65,160 +72,52 @@ FGASAbilityNode::FGASAbilityNode(
 	, GameplayTask(InTask)
 	, NodeType(EGASAbilityNodeType::Task)
 {
+	UpdateTaskCache();
 }
 
-FName FGASAbilityNode::GetName() const
+void FGASAbilityNode::Update(const FGameplayAbilitySpec& InSpec, const FGASAbilityStateVersions& InVersions)
 {
-	if (!ASC.IsValid())
-	{
-		return NAME_None;
-	}
+	const bool bAbilityChanged = AbilitySpec.Ability != InSpec.Ability;
+	AbilitySpec = InSpec;
 
-	switch (NodeType)
+	if (bAbilityChanged)
 	{
-	case EGASAbilityNodeType::Ability:
-		if (AbilitySpec.Ability)
-		{
-			FString CleanedName = ASC->CleanupName(GetNameSafe(AbilitySpec.Ability));
-			return *CleanedName;
-		}
-		return NAME_None;
-	case EGASAbilityNodeType::Task:
-		if (GameplayTask.IsValid())
-		{
-			FString DebugString = GameplayTask->GetDebugString();
-			return *DebugString;
-		}
-		return NAME_None;
+		CacheAbilityInfo();
 	}
 
-	return NAME_None;
+	UpdateCache(InVersions);
+	++Generation;
+}
+
+FName FGASAbilityNode::GetName() const
+{
+	return CachedName;
 }
 
 EGASAbilityState FGASAbilityNode::GetState() const
 {
-	// Use cached state if available
+	// Computed by UpdateCache, the ASC is gone when it was not
 	if (bStateCached)
 	{
 		return CachedState;
 	}
 
-	// Fallback to real-time reading if cache not available (shouldn't happen normally)
-	if (!ASC.IsValid())
-	{
-		return EGASAbilityState::CantActivate;
-	}
-
-	// Task nodes don't have their own state
-	if (NodeType == EGASAbilityNodeType::Task)
-	{
-		return EGASAbilityState::Active;
-	}
-
-	// Check if active
-	if (AbilitySpec.IsActive())
-	{
-		return EGASAbilityState::Active;
-	}
-
-	// Check input blocked
-	if (ASC->IsAbilityInputBlocked(AbilitySpec.InputID))
-	{
-		return EGASAbilityState::InputBlocked;
-	}
-
-	// Check tag blocked
-	if (AbilitySpec.Ability && ASC->AreAbilityTagsBlocked(AbilitySpec.Ability->GetAssetTags()))
-	{
-		return EGASAbilityState::TagBlocked;
-	}
-
-	// Check can activate
-	if (AbilitySpec.Ability && ASC->AbilityActorInfo.IsValid())
-	{
-		FGameplayTagContainer FailureTags;
-		if (!AbilitySpec.Ability->CanActivateAbility(
-			AbilitySpec.Handle, ASC->AbilityActorInfo.Get(),
-			nullptr, nullptr, &FailureTags))
-		{
-			// Check if on cooldown
-			float Cooldown = AbilitySpec.Ability->GetCooldownTimeRemaining(ASC->AbilityActorInfo.Get());
-			if (Cooldown > 0.f)
-			{
-				return EGASAbilityState::Cooldown;
-			}
-			return EGASAbilityState::CantActivate;
-		}
-	}
-
-	return EGASAbilityState::Ready;
+	return NodeType == EGASAbilityNodeType::Task ? EGASAbilityState::Active : EGASAbilityState::CantActivate;
 }
 
 FText FGASAbilityNode::GetStateText() const
 {
-	if (NodeType == EGASAbilityNodeType::Task)
+	if (NodeType == EGASAbilityNodeType::Task || !bStateCached)
 	{
 		return FText::GetEmpty();
 	}
 
-	// Use cached state text if available
-	if (bStateCached && !CachedStateText.IsEmpty())
-	{
-		return CachedStateText;
-	}
-
-	// Fallback to real-time reading if cache not available
-	EGASAbilityState State = GetState();
-
-	switch (State)
-	{
-	case EGASAbilityState::Active:
-		return FText::Format(LOCTEXT("StateActive", "Active ({0})"), FText::AsNumber(AbilitySpec.ActiveCount));
-	case EGASAbilityState::InputBlocked:
-		return LOCTEXT("StateInputBlocked", "Input Blocked");
-	case EGASAbilityState::TagBlocked:
-		return LOCTEXT("StateTagBlocked", "Tag Blocked");
-	case EGASAbilityState::Cooldown:
-		if (ASC.IsValid() && AbilitySpec.Ability && ASC->AbilityActorInfo.IsValid())
-		{
-			float Cooldown = AbilitySpec.Ability->GetCooldownTimeRemaining(ASC->AbilityActorInfo.Get());
-			return FText::Format(LOCTEXT("StateCooldown", "Cooldown ({0}s)"), FText::AsNumber(FMath::CeilToInt(Cooldown)));
-		}
-		return LOCTEXT("StateCooldownSimple", "Cooldown");
-	case EGASAbilityState::CantActivate:
-		return LOCTEXT("StateCantActivate", "Blocked");
-	case EGASAbilityState::Ready:
-	default:
-		return LOCTEXT("StateReady", "Ready");
-	}
+	return CachedStateText;
 }
 
 FLinearColor FGASAbilityNode::GetStateColor() const
 {
-	// Use cached state if available
-	if (bStateCached)
-	{
-		EGASAbilityState State = CachedState;
-		switch (State)
-		{
-		case EGASAbilityState::Active:
-			return FLinearColor::Green;
-		case EGASAbilityState::Ready:
-			return FLinearColor::White;
-		case EGASAbilityState::Cooldown:
-			return FLinearColor::Yellow;
-		case EGASAbilityState::InputBlocked:
-		case EGASAbilityState::TagBlocked:
-		case EGASAbilityState::CantActivate:
-		default:
-			return FLinearColor::Red;
-		}
-	}
-
-	// Fallback to real-time reading
-	EGASAbilityState State = GetState();
-
-	switch (State)
+	switch (GetState())
 	{
 	case EGASAbilityState::Active:
 		return FLinearColor::Green;
@@ -241,41 +140,52 @@ bool FGASAbilityNode::IsActive() const
 
 FString FGASAbilityNode::GetAbilityTriggers() const
 {
+	return CachedTriggers;
+}
+
+void FGASAbilityNode::CacheAbilityInfo()
+{
+	CachedName = NAME_None;
+	CachedTriggers.Reset();
+	CostAttributes.Reset();
+	bActivationStateValid = false;
+
 	if (!ASC.IsValid() || !AbilitySpec.Ability || NodeType != EGASAbilityNodeType::Ability)
 	{
-		return FString();
+		return;
 	}
 
-	// Get AbilityTriggers via reflection (it's protected)
-	FArrayProperty* TriggersPtr = FindFProperty<FArrayProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("AbilityTriggers"));
-	if (!TriggersPtr)
+	CachedName = *ASC->CleanupName(GetNameSafe(AbilitySpec.Ability));
+
+	if (const UGameplayEffect* CostGE = AbilitySpec.Ability->GetCostGameplayEffect())
 	{
-		return FString();
+		for (const FGameplayModifierInfo& Modifier : CostGE->Modifiers)
+		{
+			CostAttributes.AddUnique(Modifier.Attribute);
+		}
 	}
 
-	const TArray<FAbilityTriggerData>* Triggers =
-		TriggersPtr->ContainerPtrToValuePtr<TArray<FAbilityTriggerData>>(AbilitySpec.Ability);
+	// AbilityTriggers is protected, read it through the reflection cache
+	const TArray<FAbilityTriggerData>* Triggers = FGASReflectionCache::Get()
+		.GetAbilityClassInfo(AbilitySpec.Ability->GetClass())
+		.GetAbilityTriggers(AbilitySpec.Ability);
 	if (!Triggers || Triggers->Num() == 0)
 	{
-		return FString();
+		return;
 	}
 
-	FString Result;
 	for (int32 i = 0; i < Triggers->Num(); ++i)
 	{
 		const FAbilityTriggerData& Trigger = (*Triggers)[i];
-		Result += FString::Printf(TEXT("Tag: %s, Source: %s"),
+		CachedTriggers += FString::Printf(TEXT("Tag: %s, Source: %s"),
 			*Trigger.TriggerTag.ToString(),
 			*UEnum::GetDisplayValueAsText(Trigger.TriggerSource).ToString());
 
 		if (i < Triggers->Num() - 1)
 		{
-			Result += TEXT("\n");
+			CachedTriggers += TEXT("\n");
 		}
 	}
-
-	return Result;
 }
 
 FString FGASAbilityNode::GetAssetPath() const
@@ -322,114 +232,271 @@ bool FGASAbilityNode::HasValidAsset() const
 	return NodeType == EGASAbilityNodeType::Ability && AbilitySpec.Ability != nullptr;
 }
 
-void FGASAbilityNode::PopulateChildren()
+bool FGASAbilityNode::MayHaveChildren() const
 {
-	if (!ASC.IsValid() || !AbilitySpec.IsActive())
+	// Only running abilities have tasks
+	if (NodeType != EGASAbilityNodeType::Ability || !AbilitySpec.IsActive())
 	{
-		return;
+		return false;
 	}
 
-	TArray<UGameplayAbility*> Instances = AbilitySpec.GetAbilityInstances();
-
-	for (UGameplayAbility* Instance : Instances)
+	// Exact, but only reads the task arrays of the instances, task nodes are built on expansion
+	auto HasRunningTasks = [](const TArray<TObjectPtr<UGameplayAbility>>& Instances)
 	{
-		if (!Instance)
+		for (const UGameplayAbility* Instance : Instances)
 		{
-			continue;
-		}
+			if (!Instance)
+			{
+				continue;
+			}
 
-		// Get ActiveTasks via reflection (it's protected)
-		FArrayProperty* ActiveTasksPtr = FindFProperty<FArrayProperty>(
-			Instance->GetClass(), TEXT("ActiveTasks"));
-		if (!ActiveTasksPtr)
-		{
-			continue;
+			const TArray<UGameplayTask*>* ActiveTasks = FGASReflectionCache::Get()
+				.GetAbilityClassInfo(Instance->GetClass())
+				.GetActiveTasks(Instance);
+			if (ActiveTasks && ActiveTasks->ContainsByPredicate([](const UGameplayTask* Task) { return Task != nullptr; }))
+			{
+				return true;
+			}
 		}
+		return false;
+	};
 
-		const TArray<UGameplayTask*>* ActiveTasks =
-			ActiveTasksPtr->ContainerPtrToValuePtr<TArray<UGameplayTask*>>(Instance);
-		if (!ActiveTasks)
-		{
-			continue;
-		}
+	return HasRunningTasks(AbilitySpec.NonReplicatedInstances) || HasRunningTasks(AbilitySpec.ReplicatedInstances);
+}
+
+void FGASAbilityNode::UpdateChildren()
+{
+	if (NodeType == EGASAbilityNodeType::Ability && ChildrenGeneration != Generation)
+	{
+		ChildrenGeneration = Generation;
+		PopulateChildren();
+	}
+}
 
-		for (UGameplayTask* Task : *ActiveTasks)
+void FGASAbilityNode::PopulateChildren()
+{
+	TArray<UGameplayTask*, TInlineAllocator<8>> RunningTasks;
+
+	if (ASC.IsValid() && AbilitySpec.IsActive())
+	{
+		TArray<UGameplayAbility*> Instances = AbilitySpec.GetAbilityInstances();
+
+		for (UGameplayAbility* Instance : Instances)
 		{
-			if (Task)
+			if (!Instance)
 			{
-				AddChildNode(FGASAbilityNode::CreateTask(ASC, AbilitySpec, Task));
+				continue;
+			}
+
+			// ActiveTasks is protected, read it through the reflection cache
+			const TArray<UGameplayTask*>* ActiveTasks = FGASReflectionCache::Get()
+				.GetAbilityClassInfo(Instance->GetClass())
+				.GetActiveTasks(Instance);
+			if (!ActiveTasks)
+			{
+				continue;
+			}
+
+			for (UGameplayTask* Task : *ActiveTasks)
+			{
+				if (Task)
+				{
+					RunningTasks.Add(Task);
+				}
 			}
 		}
 	}
+
+	// Drop nodes of finished tasks, refresh the others in place
+	Children.RemoveAll([&RunningTasks](const TSharedRef<FGASAbilityNodeBase>& Child)
+	{
+		const FGASAbilityNode& TaskNode = static_cast<const FGASAbilityNode&>(Child.Get());
+		return !RunningTasks.Contains(TaskNode.GameplayTask.Get());
+	});
+
+	for (const TSharedRef<FGASAbilityNodeBase>& Child : Children)
+	{
+		FGASAbilityNode& TaskNode = static_cast<FGASAbilityNode&>(Child.Get());
+		RunningTasks.RemoveSingleSwap(TaskNode.GameplayTask.Get());
+		TaskNode.AbilitySpec = AbilitySpec;
+		TaskNode.UpdateTaskCache();
+	}
+
+	// Whatever is left started since the last refresh
+	for (UGameplayTask* Task : RunningTasks)
+	{
+		AddChildNode(FGASAbilityNode::CreateTask(ASC, AbilitySpec, Task));
+	}
+}
+
+void FGASAbilityNode::UpdateTaskCache()
+{
+	// Task nodes don't have their own state
+	CachedState = EGASAbilityState::Active;
+	bStateCached = ASC.IsValid();
+	CachedStateText = FText::GetEmpty();
+	CachedName = GameplayTask.IsValid() ? FName(*GameplayTask->GetDebugString()) : NAME_None;
 }
 
-void FGASAbilityNode::UpdateCache()
+void FGASAbilityNode::UpdateCache(const FGASAbilityStateVersions& InVersions)
 {
+	GASDEBUGGER_SCOPE(STAT_GASDebugger_AbilityUpdateCache);
+
 	if (!ASC.IsValid())
 	{
 		bStateCached = false;
+		bActivationStateValid = false;
 		return;
 	}
 
-	// Task nodes don't have their own state
 	if (NodeType == EGASAbilityNodeType::Task)
 	{
-		CachedState = EGASAbilityState::Active;
-		bStateCached = true;
-		CachedStateText = FText::GetEmpty();
+		UpdateTaskCache();
 		return;
 	}
 
 	// Calculate state
 	if (AbilitySpec.IsActive())
 	{
-		CachedState = EGASAbilityState::Active;
-		CachedActiveCount = AbilitySpec.ActiveCount;
-		CachedStateText = FText::Format(LOCTEXT("StateActive", "Active ({0})"), FText::AsNumber(CachedActiveCount));
+		if (!bStateCached || CachedState != EGASAbilityState::Active || CachedActiveCount != AbilitySpec.ActiveCount)
+		{
+			CachedState = EGASAbilityState::Active;
+			CachedActiveCount = AbilitySpec.ActiveCount;
+			CachedStateText = FText::Format(LOCTEXT("StateActive", "Active ({0})"), FText::AsNumber(CachedActiveCount));
+		}
+		bStateCached = true;
+		return;
 	}
-	else if (ASC->IsAbilityInputBlocked(AbilitySpec.InputID))
+
+	// Input blocking is a lookup in the ASC's binding array, cheaper than tracking it
+	if (ASC->IsAbilityInputBlocked(AbilitySpec.InputID))
 	{
-		CachedState = EGASAbilityState::InputBlocked;
-		CachedStateText = LOCTEXT("StateInputBlocked", "Input Blocked");
+		SetCachedState(EGASAbilityState::InputBlocked);
+		return;
 	}
-	else if (AbilitySpec.Ability && ASC->AreAbilityTagsBlocked(AbilitySpec.Ability->GetAssetTags()))
+
+	FActivationStateKey Key;
+	Key.OwnedTags = InVersions.OwnedTags;
+	Key.BlockedTags = InVersions.BlockedTags;
+	Key.Effects = InVersions.Effects;
+	Key.Level = AbilitySpec.Level;
+	for (const FGameplayAttribute& Attribute : CostAttributes)
 	{
-		CachedState = EGASAbilityState::TagBlocked;
-		CachedStateText = LOCTEXT("StateTagBlocked", "Tag Blocked");
+		// Counters only grow, so the sum moves whenever one of them does
+		Key.CostAttributes += InVersions.GetAttributeVersion(Attribute);
+	}
+
+	if (!bActivationStateValid || !(Key == ActivationStateKey))
+	{
+		ActivationStateKey = Key;
+		bActivationStateValid = true;
+		UpdateActivationState();
 	}
-	else if (AbilitySpec.Ability && ASC->AbilityActorInfo.IsValid())
+
+	SetCachedState(ActivationState);
+}
+
+void FGASAbilityNode::UpdateActivationState()
+{
+	ActivationState = EGASAbilityState::Ready;
+	CooldownStartTime = 0.0f;
+	CooldownDuration = 0.0f;
+
+	if (!AbilitySpec.Ability)
 	{
-		FGameplayTagContainer FailureTags;
-		if (!AbilitySpec.Ability->CanActivateAbility(
-			AbilitySpec.Handle, ASC->AbilityActorInfo.Get(),
-			nullptr, nullptr, &FailureTags))
-		{
-			// Check if on cooldown
-			CachedCooldownTime = AbilitySpec.Ability->GetCooldownTimeRemaining(ASC->AbilityActorInfo.Get());
-			if (CachedCooldownTime > 0.f)
-			{
-				CachedState = EGASAbilityState::Cooldown;
-				CachedStateText = FText::Format(LOCTEXT("StateCooldown", "Cooldown ({0}s)"), FText::AsNumber(FMath::CeilToInt(CachedCooldownTime)));
-			}
-			else
-			{
-				CachedState = EGASAbilityState::CantActivate;
-				CachedStateText = LOCTEXT("StateCantActivate", "Blocked");
-			}
-		}
-		else
+		return;
+	}
+
+	if (ASC->AreAbilityTagsBlocked(AbilitySpec.Ability->GetAssetTags()))
+	{
+		ActivationState = EGASAbilityState::TagBlocked;
+		return;
+	}
+
+	const FGameplayAbilityActorInfo* ActorInfo = ASC->AbilityActorInfo.Get();
+	if (!ActorInfo)
+	{
+		return;
+	}
+
+	FGameplayTagContainer FailureTags;
+	if (AbilitySpec.Ability->CanActivateAbility(AbilitySpec.Handle, ActorInfo, nullptr, nullptr, &FailureTags))
+	{
+		return;
+	}
+
+	// Check if on cooldown, the window is stored so the countdown does not query the effects again
+	float Remaining = 0.0f;
+	float Duration = 0.0f;
+	AbilitySpec.Ability->GetCooldownTimeRemainingAndDuration(AbilitySpec.Handle, ActorInfo, Remaining, Duration);
+	if (Remaining > 0.0f)
+	{
+		const UWorld* World = ASC->GetWorld();
+		const float Now = World ? World->GetTimeSeconds() : 0.0f;
+		ActivationState = EGASAbilityState::Cooldown;
+		CooldownDuration = FMath::Max(Duration, Remaining);
+		CooldownStartTime = Now + Remaining - CooldownDuration;
+		CooldownDisplaySeconds = INDEX_NONE;
+	}
+	else
+	{
+		ActivationState = EGASAbilityState::CantActivate;
+	}
+}
+
+void FGASAbilityNode::SetCachedState(EGASAbilityState InState)
+{
+	if (InState == EGASAbilityState::Cooldown)
+	{
+		if (!bStateCached || CachedState != EGASAbilityState::Cooldown)
 		{
-			CachedState = EGASAbilityState::Ready;
-			CachedStateText = LOCTEXT("StateReady", "Ready");
+			CooldownDisplaySeconds = INDEX_NONE;
 		}
+		CachedState = InState;
+		bStateCached = true;
+		UpdateCooldownText();
+		return;
 	}
-	else
+
+	if (bStateCached && CachedState == InState)
 	{
-		CachedState = EGASAbilityState::Ready;
-		CachedStateText = LOCTEXT("StateReady", "Ready");
+		return;
 	}
 
+	CachedState = InState;
 	bStateCached = true;
+
+	switch (InState)
+	{
+	case EGASAbilityState::InputBlocked:
+		CachedStateText = LOCTEXT("StateInputBlocked", "Input Blocked");
+		break;
+	case EGASAbilityState::TagBlocked:
+		CachedStateText = LOCTEXT("StateTagBlocked", "Tag Blocked");
+		break;
+	case EGASAbilityState::CantActivate:
+		CachedStateText = LOCTEXT("StateCantActivate", "Blocked");
+		break;
+	case EGASAbilityState::Ready:
+	default:
+		CachedStateText = LOCTEXT("StateReady", "Ready");
+		break;
+	}
+}
+
+void FGASAbilityNode::UpdateCooldownText()
+{
+	// The cooldown tag going away moves the owned tags version, until then count down from the stored window
+	const UWorld* World = ASC.IsValid() ? ASC->GetWorld() : nullptr;
+	const float Now = World ? World->GetTimeSeconds() : CooldownStartTime;
+	const float Remaining = FMath::Max(CooldownStartTime + CooldownDuration - Now, 0.0f);
+
+	const int32 DisplaySeconds = FMath::CeilToInt(Remaining);
+	if (DisplaySeconds != CooldownDisplaySeconds)
+	{
+		CooldownDisplaySeconds = DisplaySeconds;
+		CachedStateText = FText::Format(LOCTEXT("StateCooldown", "Cooldown ({0}s)"), FText::AsNumber(DisplaySeconds));
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -444,16 +511,6 @@ void SGASAbilityTreeItem::Construct(const FArguments& InArgs, const TSharedRef<S
 
 	check(NodeInfo.IsValid());
 
-	// Cache data
-	CachedName = NodeInfo->GetName();
-	CachedStateText = NodeInfo->GetStateText();
-	bCachedIsActive = NodeInfo->IsActive();
-	CachedNodeType = NodeInfo->GetNodeType();
-	CachedState = NodeInfo->GetState();
-	CachedTriggers = NodeInfo->GetAbilityTriggers();
-	CachedAssetPath = NodeInfo->GetAssetPath();
-	CachedStateColor = NodeInfo->GetStateColor();
-
 	SMultiColumnTableRow<TSharedRef<FGASAbilityNodeBase>>::Construct(
 		SMultiColumnTableRow<TSharedRef<FGASAbilityNodeBase>>::FArguments().Padding(0),
 		InOwnerTableView);
@@ -465,12 +522,12 @@ TSharedRef<SWidget> SGASAbilityTreeItem::GenerateWidgetForColumn(const FName& Co
 	{
 		TSharedPtr<SWidget> NameWidget;
 
-		if (CachedNodeType == EGASAbilityNodeType::Ability && NodeInfo->HasValidAsset())
+		if (NodeInfo->GetNodeType() == EGASAbilityNodeType::Ability && NodeInfo->HasValidAsset())
 		{
 			// Hyperlink for navigating to asset
 			NameWidget = SNew(SHyperlink)
 				.Text(this, &SGASAbilityTreeItem::GetNameText)
-				.ToolTipText(FText::FromString(CachedAssetPath))
+				.ToolTipText(FText::FromString(NodeInfo->GetAssetPath()))
 				.OnNavigate(this, &SGASAbilityTreeItem::HandleHyperlinkNavigate);
 		}
 		else
@@ -515,7 +572,7 @@ TSharedRef<SWidget> SGASAbilityTreeItem::GenerateWidgetForColumn(const FName& Co
 			[
 				SNew(STextBlock)
 				.Text(this, &SGASAbilityTreeItem::GetStateIconText)
-				.ColorAndOpacity(FSlateColor(CachedStateColor))
+				.ColorAndOpacity(this, &SGASAbilityTreeItem::GetStateColor)
 				.Font(FAppStyle::GetFontStyle("Bold"))
 			]
 			+ SHorizontalBox::Slot()
@@ -523,17 +580,13 @@ TSharedRef<SWidget> SGASAbilityTreeItem::GenerateWidgetForColumn(const FName& Co
 			.VAlign(VAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(CachedStateText)
-				.ColorAndOpacity(FSlateColor(CachedStateColor))
+				.Text(this, &SGASAbilityTreeItem::GetStateText)
+				.ColorAndOpacity(this, &SGASAbilityTreeItem::GetStateColor)
 				.Justification(ETextJustify::Left)
 			];
 	}
 	else if (ColumnName == GASAbilityColumns::IsActive)
 	{
-		FText ActiveText = bCachedIsActive
-			? LOCTEXT("ActiveYes", "Yes")
-			: LOCTEXT("ActiveNo", "No");
-
 		return SNew(SBorder)
 			.HAlign(HAlign_Left)
 			.VAlign(VAlign_Center)
@@ -543,7 +596,7 @@ TSharedRef<SWidget> SGASAbilityTreeItem::GenerateWidgetForColumn(const FName& Co
 			.ColorAndOpacity(this, &SGASAbilityTreeItem::GetStateLinearColor)
 			[
 				SNew(STextBlock)
-				.Text(ActiveText)
+				.Text(this, &SGASAbilityTreeItem::GetActiveText)
 				.Justification(ETextJustify::Left)
 			];
 	}
@@ -557,8 +610,8 @@ TSharedRef<SWidget> SGASAbilityTreeItem::GenerateWidgetForColumn(const FName& Co
 			.BorderBackgroundColor(FSlateColor(FLinearColor(1.f, 1.f, 1.f, 0.f)))
 			[
 				SNew(STextBlock)
-				.Text(FText::FromString(CachedTriggers))
-				.ToolTipText(FText::FromString(CachedTriggers))
+				.Text(this, &SGASAbilityTreeItem::GetTriggersText)
+				.ToolTipText(this, &SGASAbilityTreeItem::GetTriggersText)
 				.Justification(ETextJustify::Left)
 			];
 	}
@@ -570,14 +623,15 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 void SGASAbilityTreeItem::HandleHyperlinkNavigate()
 {
-	if (CachedAssetPath.IsEmpty())
+	const FString AssetPath = NodeInfo->GetAssetPath();
+	if (AssetPath.IsEmpty())
 	{
 		return;
 	}
 
 #if WITH_EDITOR
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(*CachedAssetPath));
+	FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(*AssetPath));
 
 	if (AssetData.IsValid())
 	{
@@ -592,27 +646,44 @@ void SGASAbilityTreeItem::HandleHyperlinkNavigate()
 
 FText SGASAbilityTreeItem::GetNameText() const
 {
-	return FText::FromName(CachedName);
+	return FText::FromName(NodeInfo->GetName());
 }
 
 FSlateColor SGASAbilityTreeItem::GetStateColor() const
 {
-	return FSlateColor(CachedStateColor);
+	return FSlateColor(NodeInfo->GetStateColor());
 }
 
 FLinearColor SGASAbilityTreeItem::GetStateLinearColor() const
 {
-	return CachedStateColor;
+	return NodeInfo->GetStateColor();
+}
+
+FText SGASAbilityTreeItem::GetStateText() const
+{
+	return NodeInfo->GetStateText();
+}
+
+FText SGASAbilityTreeItem::GetActiveText() const
+{
+	return NodeInfo->IsActive()
+		? LOCTEXT("ActiveYes", "Yes")
+		: LOCTEXT("ActiveNo", "No");
+}
+
+FText SGASAbilityTreeItem::GetTriggersText() const
+{
+	return FText::FromString(NodeInfo->GetAbilityTriggers());
 }
 
 FText SGASAbilityTreeItem::GetStateIconText() const
 {
-	if (CachedNodeType == EGASAbilityNodeType::Task)
+	if (NodeInfo->GetNodeType() == EGASAbilityNodeType::Task)
 	{
 		return FText::GetEmpty();
 	}
 
-	switch (CachedState)
+	switch (NodeInfo->GetState())
 	{
 	case EGASAbilityState::Active:
 		return FText::FromString(TEXT("[A]"));  // Active
@@ -642,21 +713,16 @@ void FGASAbilityNode::GetCooldownInfo(float& OutRemaining, float& OutDuration) c
 	OutRemaining = 0.0f;
 	OutDuration = 0.0f;
 
-	if (!AbilitySpec.Ability || !ASC.IsValid() || !ASC->AbilityActorInfo.IsValid())
+	// Read from the window stored with the activation state, so the details panel does not query the effects
+	if (!bStateCached || CachedState != EGASAbilityState::Cooldown)
 	{
 		return;
 	}
 
-	// Get remaining cooldown time
-	OutRemaining = AbilitySpec.Ability->GetCooldownTimeRemaining(ASC->AbilityActorInfo.Get());
-
-	// Get total cooldown duration from cooldown gameplay effect
-	const UGameplayEffect* CooldownGE = AbilitySpec.Ability->GetCooldownGameplayEffect();
-	if (CooldownGE)
-	{
-		// Try to get duration magnitude
-		OutDuration = CooldownGE->DurationMagnitude.GetStaticMagnitudeIfPossible(1.0f, OutDuration);
-	}
+	const UWorld* World = ASC.IsValid() ? ASC->GetWorld() : nullptr;
+	const float Now = World ? World->GetTimeSeconds() : CooldownStartTime;
+	OutRemaining = FMath::Max(CooldownStartTime + CooldownDuration - Now, 0.0f);
+	OutDuration = CooldownDuration;
 }
 
 FGameplayTagContainer FGASAbilityNode::GetCooldownTags() const
@@ -744,188 +810,52 @@ FGameplayTagContainer FGASAbilityNode::GetAbilityTags() const
 	return AbilitySpec.Ability->GetAssetTags();
 }
 
-FGameplayTagContainer FGASAbilityNode::GetActivationOwnedTags() const
+FGameplayTagContainer FGASAbilityNode::GetReflectedTags(EGASAbilityTagProperty Tags) const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("ActivationOwnedTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
+	// Protected members, read through the per-class reflection cache
+	const FGASAbilityClassInfo& ClassInfo = FGASReflectionCache::Get().GetAbilityClassInfo(AbilitySpec.Ability ? AbilitySpec.Ability->GetClass() : nullptr);
+	const FGameplayTagContainer* TagContainer = ClassInfo.GetTags(AbilitySpec.Ability, Tags);
+	return TagContainer ? *TagContainer : FGameplayTagContainer();
+}
 
-	return FGameplayTagContainer();
+FGameplayTagContainer FGASAbilityNode::GetActivationOwnedTags() const
+{
+	return GetReflectedTags(EGASAbilityTagProperty::ActivationOwned);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetActivationRequiredTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("ActivationRequiredTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::ActivationRequired);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetActivationBlockedTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("ActivationBlockedTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::ActivationBlocked);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetSourceRequiredTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("SourceRequiredTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::SourceRequired);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetSourceBlockedTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("SourceBlockedTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::SourceBlocked);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetTargetRequiredTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("TargetRequiredTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::TargetRequired);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetTargetBlockedTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("TargetBlockedTags"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::TargetBlocked);
 }
 
 FGameplayTagContainer FGASAbilityNode::GetCancelAbilitiesWithTags() const
 {
-	if (!AbilitySpec.Ability)
-	{
-		return FGameplayTagContainer();
-	}
-
-	// Access protected member via reflection
-	FStructProperty* TagsPtr = FindFProperty<FStructProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("CancelAbilitiesWithTag"));
-	if (TagsPtr)
-	{
-		const FGameplayTagContainer* Tags =
-			TagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (Tags)
-		{
-			return *Tags;
-		}
-	}
-
-	return FGameplayTagContainer();
+	return GetReflectedTags(EGASAbilityTagProperty::CancelAbilitiesWith);
 }
 
 const UGameplayEffect* FGASAbilityNode::GetCostGameplayEffectClass() const
@@ -950,15 +880,8 @@ bool FGASAbilityNode::ActivatesOnGranted() const
 		return false;
 	}
 
-	// Access protected member via reflection since bActivateAbilityOnGranted may not exist in UE 5.4
-	FBoolProperty* BoolPtr = FindFProperty<FBoolProperty>(
-		AbilitySpec.Ability->GetClass(), TEXT("bActivateAbilityOnGranted"));
-	if (BoolPtr)
-	{
-		return BoolPtr->GetPropertyValue_InContainer(AbilitySpec.Ability);
-	}
-
-	return false;
+	// bActivateAbilityOnGranted may not exist in UE 5.4, the cache leaves it null then
+	return FGASReflectionCache::Get().GetAbilityClassInfo(AbilitySpec.Ability->GetClass()).ActivatesOnGranted(AbilitySpec.Ability);
 }
 
 bool FGASAbilityNode::ActivatesOnInput() const
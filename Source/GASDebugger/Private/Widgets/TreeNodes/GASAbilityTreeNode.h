@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameplayAbilitySpec.h"
 #include "GameplayTask.h"
+#include "GASDebuggerTypes.h"
 #include "Widgets/Views/STableViewBase.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/STreeView.h"
 
 class UAbilitySystemComponent;
 class STableViewBase;
+enum class EGASAbilityTagProperty : uint8;
 
 /** Node type in the ability tree */
 enum class EGASAbilityNodeType : uint8
@@ -72,10 +74,16 @@ public:
 	/** Check if has valid asset to navigate to */
 	virtual bool HasValidAsset() const = 0;
 
+	/** Cheap check for the expander arrow, answered without building the children */
+	virtual bool MayHaveChildren() const { return Children.Num() > 0; }
+
+	/** Build or refresh the children if the node changed since they were last built */
+	virtual void UpdateChildren() {}
+
 	/** Add a child node */
 	void AddChildNode(TSharedRef<FGASAbilityNodeBase> InChild);
 
-	/** Get children */
+	/** Get children as of the last UpdateChildren */
 	const TArray<TSharedRef<FGASAbilityNodeBase>>& GetChildren() const { return Children; }
 
 protected:
@@ -93,7 +101,8 @@ public:
 	/** Create an ability node */
 	static TSharedRef<FGASAbilityNode> Create(
 		TWeakObjectPtr<UAbilitySystemComponent> InASC,
-		const FGameplayAbilitySpec& InSpec);
+		const FGameplayAbilitySpec& InSpec,
+		const FGASAbilityStateVersions& InVersions);
 
 	/** Create a task node */
 	static TSharedRef<FGASAbilityNode> CreateTask(
@@ -111,9 +120,17 @@ public:
 	virtual FString GetAbilityTriggers() const override;
 	virtual FString GetAssetPath() const override;
 	virtual bool HasValidAsset() const override;
+	virtual bool MayHaveChildren() const override;
+	virtual void UpdateChildren() override;
 
-	/** Update cached state data (call this when refreshing) */
-	void UpdateCache();
+	/**
+	 * Update cached state data (call this when refreshing).
+	 * CanActivateAbility only runs again when tags, effects, the cost attributes or the level changed since the last call.
+	 */
+	void UpdateCache(const FGASAbilityStateVersions& InVersions);
+
+	/** Refresh this node in place from the current spec, task children are refreshed by the next UpdateChildren */
+	void Update(const FGameplayAbilitySpec& InSpec, const FGASAbilityStateVersions& InVersions);
 
 	// Getter methods for detailed information display
 
@@ -192,16 +209,35 @@ public:
 private:
 	explicit FGASAbilityNode(
 		TWeakObjectPtr<UAbilitySystemComponent> InASC,
-		const FGameplayAbilitySpec& InSpec);
+		const FGameplayAbilitySpec& InSpec,
+		const FGASAbilityStateVersions& InVersions);
 
 	explicit FGASAbilityNode(
 		TWeakObjectPtr<UAbilitySystemComponent> InASC,
 		const FGameplayAbilitySpec& InSpec,
 		TWeakObjectPtr<UGameplayTask> InTask);
 
-	/** Populate ActiveTasks as children */
+	/** Sync children with the ActiveTasks of the ability instances, keeping nodes of tasks still running */
 	void PopulateChildren();
 
+	/** Cache data that only depends on the ability class (name, triggers, cost attributes) */
+	void CacheAbilityInfo();
+
+	/** Task nodes only cache their name */
+	void UpdateTaskCache();
+
+	/** Run the tag, cooldown and cost checks and store the cooldown window */
+	void UpdateActivationState();
+
+	/** Set the cached state and its text, the text is only rebuilt when the state changed */
+	void SetCachedState(EGASAbilityState InState);
+
+	/** Rebuild the cooldown text from the stored cooldown window when the displayed second changed */
+	void UpdateCooldownText();
+
+	/** Read a protected tag container of the ability */
+	FGameplayTagContainer GetReflectedTags(EGASAbilityTagProperty Tags) const;
+
 private:
 	TWeakObjectPtr<UAbilitySystemComponent> ASC;
 	FGameplayAbilitySpec AbilitySpec;
@@ -212,8 +248,60 @@ private:
 	mutable EGASAbilityState CachedState = EGASAbilityState::Ready;
 	mutable bool bStateCached = false;
 	mutable FText CachedStateText;
-	mutable float CachedCooldownTime = 0.0f;
 	mutable int32 CachedActiveCount = 0;
+	FName CachedName;
+	FString CachedTriggers;
+
+	/** What the activation state was last computed from */
+	struct FActivationStateKey
+	{
+		uint32 OwnedTags = 0;
+		uint32 BlockedTags = 0;
+		uint32 Effects = 0;
+		uint32 CostAttributes = 0;
+		int32 Level = 0;
+
+		bool operator==(const FActivationStateKey& Other) const
+		{
+			return OwnedTags == Other.OwnedTags && BlockedTags == Other.BlockedTags && Effects == Other.Effects
+				&& CostAttributes == Other.CostAttributes && Level == Other.Level;
+		}
+	};
+
+	/** Result of the last tag, cooldown and cost checks, reused while the key matches */
+	EGASAbilityState ActivationState = EGASAbilityState::Ready;
+	FActivationStateKey ActivationStateKey;
+	bool bActivationStateValid = false;
+
+	/** Attributes the cost effect modifies */
+	TArray<FGameplayAttribute, TInlineAllocator<2>> CostAttributes;
+
+	/** Cooldown window in world time, stored with the activation state */
+	float CooldownStartTime = 0.0f;
+	float CooldownDuration = 0.0f;
+	int32 CooldownDisplaySeconds = INDEX_NONE;
+
+	/** Incremented by every Update, task children are rebuilt when they are older */
+	uint32 Generation = 1;
+	uint32 ChildrenGeneration = 0;
+};
+
+/**
+ * Stand-in child of a collapsed row, so the tree shows its expander without building the real children.
+ * Never generates a row, the children replace it on expansion.
+ */
+class FGASAbilityPlaceholderNode : public FGASAbilityNodeBase
+{
+public:
+	virtual FName GetName() const override { return NAME_None; }
+	virtual EGASAbilityNodeType GetNodeType() const override { return EGASAbilityNodeType::Task; }
+	virtual EGASAbilityState GetState() const override { return EGASAbilityState::Ready; }
+	virtual FText GetStateText() const override { return FText::GetEmpty(); }
+	virtual FLinearColor GetStateColor() const override { return FLinearColor::White; }
+	virtual bool IsActive() const override { return false; }
+	virtual FString GetAbilityTriggers() const override { return FString(); }
+	virtual FString GetAssetPath() const override { return FString(); }
+	virtual bool HasValidAsset() const override { return false; }
 };
 
 /** Tree row widget for abilities */
@@ -246,16 +334,16 @@ protected:
 	/** Get state icon text */
 	FText GetStateIconText() const;
 
+	/** Get state display text */
+	FText GetStateText() const;
+
+	/** Get active column text */
+	FText GetActiveText() const;
+
+	/** Get triggers text */
+	FText GetTriggersText() const;
+
 private:
+	/** Nodes are updated in place on refresh, so every column reads from the node instead of caching at construction */
 	TSharedPtr<FGASAbilityNodeBase> NodeInfo;
-
-	// Cached data
-	FName CachedName;
-	FText CachedStateText;
-	bool bCachedIsActive = false;
-	EGASAbilityNodeType CachedNodeType = EGASAbilityNodeType::Ability;
-	EGASAbilityState CachedState = EGASAbilityState::Ready;
-	FString CachedTriggers;
-	FString CachedAssetPath;
-	FLinearColor CachedStateColor = FLinearColor::White;
 };
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Widgets/TreeNodes/GASAttributeTreeNode.h"
+#include "Core/GASDebuggerStats.h"
 #include "GASDebuggerTypes.h"
 #include "AbilitySystemComponent.h"
 #include "Widgets/Views/STableRow.h"
@@ -49,6 +50,7 @@ void FGASAttributeNodeBase::AddChildNode(TSharedRef<FGASAttributeNodeBase> InChi
 
 TSharedRef<FGASAttributeSetNode> FGASAttributeSetNode::Create(const FName& InAttributeSetName)
 {
+	GASDEBUGGER_COUNT_NODE(FGASAttributeSetNode);
 	return MakeShared<FGASAttributeSetNode>(InAttributeSetName);
 }
 
@@ -65,35 +67,53 @@ FText FGASAttributeSetNode::GetDisplayText() const
 //////////////////////////////////////////////////////////////////////////
 // FGASAttributeNode
 
-TSharedRef<FGASAttributeNode> FGASAttributeNode::Create(const FGASAttributeInfo& InAttributeInfo)
+TSharedRef<FGASAttributeNode> FGASAttributeNode::Create(const FGASAttributeRow& InRow)
 {
-	return MakeShared<FGASAttributeNode>(InAttributeInfo);
+	GASDEBUGGER_COUNT_NODE(FGASAttributeNode);
+	return MakeShared<FGASAttributeNode>(InRow);
 }
 
-FGASAttributeNode::FGASAttributeNode(const FGASAttributeInfo& InAttributeInfo)
-	: AttributeInfo(InAttributeInfo)
+FGASAttributeNode::FGASAttributeNode(const FGASAttributeRow& InRow)
 {
+	Update(InRow);
 }
 
-FName FGASAttributeNode::GetDisplayName() const
+void FGASAttributeNode::Update(const FGASAttributeRow& InRow)
 {
-	if (!AttributeInfo.Attribute.IsValid())
+	// Texts were formatted when the row was built, off the game thread
+	AttributeInfo = InRow.Info;
+	CachedDisplayText = InRow.DisplayText;
+	CachedBaseValueText = InRow.BaseValueText;
+	CachedCurrentValueText = InRow.CurrentValueText;
+
+	// Modifier children are matched by position, only the tail is created or dropped
+	const int32 NumModifiers = InRow.Modifiers.Num();
+	if (Children.Num() > NumModifiers)
 	{
-		return NAME_None;
+		Children.SetNum(NumModifiers);
 	}
-	FString AttrNameStr = AttributeInfo.Attribute.GetName();
-	return FName(*AttrNameStr);
+
+	for (int32 ModIdx = 0; ModIdx < NumModifiers; ++ModIdx)
+	{
+		if (Children.IsValidIndex(ModIdx))
+		{
+			StaticCastSharedRef<FGASAttributeModifierNode>(Children[ModIdx])->Update(InRow.Modifiers[ModIdx]);
+		}
+		else
+		{
+			AddChildNode(FGASAttributeModifierNode::Create(InRow.Modifiers[ModIdx]));
+		}
+	}
+}
+
+FName FGASAttributeNode::GetDisplayName() const
+{
+	return AttributeInfo.AttributeName;
 }
 
 FText FGASAttributeNode::GetDisplayText() const
 {
-	if (!AttributeInfo.Attribute.IsValid())
-	{
-		return FText::FromString(TEXT("(Invalid)"));
-	}
-	
-	FString AttrNameStr = AttributeInfo.Attribute.GetName();
-	return FText::FromString(AttrNameStr);
+	return CachedDisplayText;
 }
 
 float FGASAttributeNode::GetChangePercent() const
@@ -106,6 +126,29 @@ float FGASAttributeNode::GetChangePercent() const
 	return (AttributeInfo.CurrentValue - Base) / Base;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// FGASAttributeModifierNode
+
+TSharedRef<FGASAttributeModifierNode> FGASAttributeModifierNode::Create(const FGASAttributeModifierRow& InRow)
+{
+	GASDEBUGGER_COUNT_NODE(FGASAttributeModifierNode);
+	return MakeShared<FGASAttributeModifierNode>(InRow);
+}
+
+FGASAttributeModifierNode::FGASAttributeModifierNode(const FGASAttributeModifierRow& InRow)
+{
+	Update(InRow);
+}
+
+void FGASAttributeModifierNode::Update(const FGASAttributeModifierRow& InRow)
+{
+	ModifierInfo = InRow.Info;
+	CachedEffectName = InRow.EffectName;
+	CachedDisplayText = InRow.DisplayText;
+	CachedOperationText = InRow.OperationText;
+	CachedMagnitudeText = InRow.MagnitudeText;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // SGASAttributeTreeItem
 
@@ -116,18 +159,6 @@ void SGASAttributeTreeItem::Construct(const FArguments& InArgs, const TSharedRef
 
 	check(NodeInfo.IsValid());
 
-	// Cache data
-	bIsGroupNode = NodeInfo->IsGroupNode();
-	CachedDisplayText = NodeInfo->GetDisplayText();
-	
-	if (!bIsGroupNode)
-	{
-		CachedBaseValue = NodeInfo->GetBaseValue();
-		CachedCurrentValue = NodeInfo->GetCurrentValue();
-		CachedChangeColor = NodeInfo->GetChangeColor();
-		bHasModifier = !FMath::IsNearlyEqual(CachedBaseValue, CachedCurrentValue);
-	}
-
 	SMultiColumnTableRow<TSharedRef<FGASAttributeNodeBase>>::Construct(
 		SMultiColumnTableRow<TSharedRef<FGASAttributeNodeBase>>::FArguments().Padding(0),
 		InOwnerTableView);
@@ -135,6 +166,8 @@ void SGASAttributeTreeItem::Construct(const FArguments& InArgs, const TSharedRef
 
 TSharedRef<SWidget> SGASAttributeTreeItem::GenerateWidgetForColumn(const FName& ColumnName)
 {
+	const bool bIsGroupNode = NodeInfo->IsGroupNode();
+
 	if (ColumnName == GASAttributeColumns::Name)
 	{
 		if (bIsGroupNode)
@@ -154,13 +187,13 @@ TSharedRef<SWidget> SGASAttributeTreeItem::GenerateWidgetForColumn(const FName&
 				.Padding(4, 2)
 				[
 					SNew(STextBlock)
-					.Text(CachedDisplayText)
+					.Text(this, &SGASAttributeTreeItem::GetDisplayText)
 					.Font(FAppStyle::GetFontStyle("Bold"))
 				];
 		}
 		else
 		{
-			// Attribute node
+			// Attribute or modifier node
 			return SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot()
 				.AutoWidth()
@@ -175,7 +208,8 @@ TSharedRef<SWidget> SGASAttributeTreeItem::GenerateWidgetForColumn(const FName&
 				.Padding(4, 2)
 				[
 					SNew(STextBlock)
-					.Text(CachedDisplayText)
+					.Text(this, &SGASAttributeTreeItem::GetDisplayText)
+					.ColorAndOpacity(FSlateColor(NodeInfo->IsModifierNode() ? FLinearColor::Gray : FLinearColor::White))
 				];
 		}
 	}
@@ -193,8 +227,7 @@ TSharedRef<SWidget> SGASAttributeTreeItem::GenerateWidgetForColumn(const FName&
 			.Padding(4, 2)
 			[
 				SNew(STextBlock)
-				.Text(FText::Format(LOCTEXT("BaseFormat", "Base: {0}"),
-					FText::AsNumber(CachedBaseValue, &FNumberFormattingOptions::DefaultWithGrouping())))
+				.Text(this, &SGASAttributeTreeItem::GetBaseValueText)
 				.ColorAndOpacity(FSlateColor(FLinearColor::Gray))
 			];
 	}
@@ -212,14 +245,33 @@ TSharedRef<SWidget> SGASAttributeTreeItem::GenerateWidgetForColumn(const FName&
 			.Padding(4, 2)
 			[
 				SNew(STextBlock)
-				.Text(FText::Format(LOCTEXT("CurrentFormat", "Current: {0}"),
-					FText::AsNumber(CachedCurrentValue, &FNumberFormattingOptions::DefaultWithGrouping())))
-				.ColorAndOpacity(FSlateColor(bHasModifier ? CachedChangeColor : FLinearColor::White))
+				.Text(this, &SGASAttributeTreeItem::GetCurrentValueText)
+				.ColorAndOpacity(this, &SGASAttributeTreeItem::GetCurrentValueColor)
 			];
 	}
 
 	return SNullWidget::NullWidget;
 }
 
-#undef LOCTEXT_NAMESPACE
+FText SGASAttributeTreeItem::GetDisplayText() const
+{
+	return NodeInfo->GetDisplayText();
+}
+
+FText SGASAttributeTreeItem::GetBaseValueText() const
+{
+	return NodeInfo->GetBaseValueText();
+}
 
+FText SGASAttributeTreeItem::GetCurrentValueText() const
+{
+	return NodeInfo->GetCurrentValueText();
+}
+
+FSlateColor SGASAttributeTreeItem::GetCurrentValueColor() const
+{
+	// White for modifiers, groups and unmodified attributes
+	return FSlateColor(NodeInfo->GetChangeColor());
+}
+
+#undef LOCTEXT_NAMESPACE
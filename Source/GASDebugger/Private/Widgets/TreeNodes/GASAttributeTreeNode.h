@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GASDebuggerTypes.h"
+#include "Core/GASAttributeModel.h"
 #include "AbilitySystemComponent.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/STreeView.h"
@@ -40,6 +41,12 @@ public:
 	/** Get change color based on value change */
 	virtual FLinearColor GetChangeColor() const;
 
+	/** Get text of the base value column */
+	virtual FText GetBaseValueText() const { return FText::GetEmpty(); }
+
+	/** Get text of the current value column */
+	virtual FText GetCurrentValueText() const { return FText::GetEmpty(); }
+
 	/** Check if this is a group node (AttributeSet) */
 	virtual bool IsGroupNode() const { return false; }
 
@@ -75,25 +82,61 @@ private:
 	FName AttributeSetName;
 };
 
-/** Attribute node representing a single attribute */
+/** Attribute node representing a single attribute, with the modifiers affecting it as children */
 class FGASAttributeNode : public FGASAttributeNodeBase
 {
 public:
-	static TSharedRef<FGASAttributeNode> Create(const FGASAttributeInfo& InAttributeInfo);
+	static TSharedRef<FGASAttributeNode> Create(const FGASAttributeRow& InRow);
 
 	virtual FName GetDisplayName() const override;
 	virtual FText GetDisplayText() const override;
 	virtual float GetBaseValue() const override { return AttributeInfo.BaseValue; }
 	virtual float GetCurrentValue() const override { return AttributeInfo.CurrentValue; }
 	virtual float GetChangePercent() const override;
+	virtual FText GetBaseValueText() const override { return CachedBaseValueText; }
+	virtual FText GetCurrentValueText() const override { return CachedCurrentValueText; }
 
 	const FGASAttributeInfo& GetAttributeInfo() const { return AttributeInfo; }
 
+	/** Take the values and texts of a prebuilt row, modifier children are updated in place */
+	void Update(const FGASAttributeRow& InRow);
+
 public:
-	explicit FGASAttributeNode(const FGASAttributeInfo& InAttributeInfo);
+	explicit FGASAttributeNode(const FGASAttributeRow& InRow);
 
 private:
 	FGASAttributeInfo AttributeInfo;
+	FText CachedDisplayText;
+	FText CachedBaseValueText;
+	FText CachedCurrentValueText;
+};
+
+/** Modifier node representing one active effect modifier of an attribute */
+class FGASAttributeModifierNode : public FGASAttributeNodeBase
+{
+public:
+	static TSharedRef<FGASAttributeModifierNode> Create(const FGASAttributeModifierRow& InRow);
+
+	virtual FName GetDisplayName() const override { return CachedEffectName; }
+	virtual FText GetDisplayText() const override { return CachedDisplayText; }
+	virtual bool IsModifierNode() const override { return true; }
+	virtual FText GetBaseValueText() const override { return CachedOperationText; }
+	virtual FText GetCurrentValueText() const override { return CachedMagnitudeText; }
+
+	const FGASModifierInfo& GetModifierInfo() const { return ModifierInfo; }
+
+	/** Take the values and texts of a prebuilt row */
+	void Update(const FGASAttributeModifierRow& InRow);
+
+public:
+	explicit FGASAttributeModifierNode(const FGASAttributeModifierRow& InRow);
+
+private:
+	FGASModifierInfo ModifierInfo;
+	FName CachedEffectName;
+	FText CachedDisplayText;
+	FText CachedOperationText;
+	FText CachedMagnitudeText;
 };
 
 /** Tree row widget for attributes */
@@ -111,14 +154,13 @@ public:
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
 
 private:
-	TSharedPtr<FGASAttributeNodeBase> NodeInfo;
+	FText GetDisplayText() const;
+	FText GetBaseValueText() const;
+	FText GetCurrentValueText() const;
+	FSlateColor GetCurrentValueColor() const;
 
-	// Cached data
-	FText CachedDisplayText;
-	float CachedBaseValue = 0.0f;
-	float CachedCurrentValue = 0.0f;
-	FLinearColor CachedChangeColor = FLinearColor::White;
-	bool bIsGroupNode = false;
-	bool bHasModifier = false;
+private:
+	/** Nodes are updated in place on refresh, so every column reads from the node instead of caching at construction */
+	TSharedPtr<FGASAttributeNodeBase> NodeInfo;
 };
 
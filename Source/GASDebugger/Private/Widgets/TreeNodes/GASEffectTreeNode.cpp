@@ -1,8 +1,10 @@
 // Copyright Qiu, Inc. All Rights Reserved.
 
 #include "Widgets/TreeNodes/GASEffectTreeNode.h"
+#include "Core/GASDebuggerStats.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
 #include "Engine/World.h"
 #include "SlateOptMacros.h"
 #include "Widgets/Text/STextBlock.h"
@@ -27,66 +29,90 @@ void FGASEffectNodeBase::AddChildNode(TSharedRef<FGASEffectNodeBase> InChild)
 
 TSharedRef<FGASEffectNode> FGASEffectNode::Create(
 	const UWorld* InWorld,
-	const FActiveGameplayEffect& InEffect)
+	const FGASEffectSnapshot& InSnapshot)
 {
-	return MakeShareable(new FGASEffectNode(InWorld, InEffect));
+	GASDEBUGGER_COUNT_NODE(FGASEffectNode);
+	TSharedRef<FGASEffectNode> Node = MakeShareable(new FGASEffectNode(InWorld));
+	Node->Update(InWorld, InSnapshot);
+	return Node;
 }
 
 TSharedRef<FGASEffectNode> FGASEffectNode::CreateModifier(
-	const FModifierSpec* InModSpec,
-	const FGameplayModifierInfo* InModInfo)
+	const TSharedRef<FGASEffectNode>& InParent,
+	int32 InModifierIndex)
 {
-	return MakeShareable(new FGASEffectNode(InModSpec, InModInfo));
+	GASDEBUGGER_COUNT_NODE(FGASEffectNode);
+	return MakeShareable(new FGASEffectNode(InParent, InModifierIndex));
 }
 
-FGASEffectNode::FGASEffectNode(
-	const UWorld* InWorld,
-	const FActiveGameplayEffect& InEffect)
-	: World(InWorld), GameplayEffect(InEffect), ModSpec(nullptr), ModInfo(nullptr)
+FGASEffectNode::FGASEffectNode(const UWorld* InWorld)
+	: World(InWorld)
 {
-	PopulateModifiers();
 }
 
 FGASEffectNode::FGASEffectNode(
-	const FModifierSpec* InModSpec,
-	const FGameplayModifierInfo* InModInfo)
-	: World(nullptr), ModSpec(InModSpec), ModInfo(InModInfo)
+	const TSharedRef<FGASEffectNode>& InParent,
+	int32 InModifierIndex)
+	: World(nullptr), ParentNode(InParent), ModifierIndex(InModifierIndex)
 {
+	UpdateCache();
 }
 
-FName FGASEffectNode::GetName() const
+void FGASEffectNode::Update(const UWorld* InWorld, const FGASEffectSnapshot& InSnapshot)
 {
-	if (ModSpec && ModInfo)
+	World = InWorld;
+
+	PreviousGrantedTagIndices = Snapshot.GrantedTagIndices;
+	Snapshot = InSnapshot;
+
+	// The snapshot already holds the display name, the _C suffix is stripped once per definition
+	CachedName = Snapshot.EffectClassName;
+
+	UpdateCache();
+	++Generation;
+}
+
+void FGASEffectNode::UpdateChildren()
+{
+	if (!IsModifierNode() && ChildrenGeneration != Generation)
 	{
-		return *ModInfo->Attribute.GetName();
+		ChildrenGeneration = Generation;
+		PopulateModifiers();
 	}
+}
 
-	// Get clean class name instead of CDO name (which has "Default__" prefix)
-	if (const UGameplayEffect* Def = GameplayEffect.Spec.Def)
+const FGASModifierSnapshot* FGASEffectNode::GetModifier() const
+{
+	TSharedPtr<FGASEffectNode> Parent = ParentNode.Pin();
+	if (!Parent.IsValid() || !Parent->Snapshot.Modifiers.IsValidIndex(ModifierIndex))
 	{
-		FString ClassName = Def->GetClass()->GetName();
-		// Remove "_C" suffix for Blueprint classes
-		if (ClassName.EndsWith(TEXT("_C")))
-		{
-			ClassName.LeftChopInline(2);
-		}
-		return *ClassName;
+		return nullptr;
 	}
+	return &Parent->Snapshot.Modifiers[ModifierIndex];
+}
 
-	return NAME_None;
+FName FGASEffectNode::GetName() const
+{
+	return CachedName;
 }
 
 FText FGASEffectNode::GetDurationText() const
 {
 	// For modifier nodes, show the modifier info
-	if (ModSpec && ModInfo)
+	if (IsModifierNode())
 	{
+		const FGASModifierSnapshot* Modifier = GetModifier();
+		if (!Modifier)
+		{
+			return FText::GetEmpty();
+		}
+
 		UEnum* OpEnum = StaticEnum<EGameplayModOp::Type>();
-		FString ModifierOpStr = OpEnum->GetNameStringByValue(static_cast<int64>(ModInfo->ModifierOp));
+		FString ModifierOpStr = OpEnum->GetNameStringByValue(static_cast<int64>(Modifier->Operation));
 		return FText::Format(
 			LOCTEXT("ModifierInfo", "Mod: {0}, Value: {1}"),
 			FText::FromString(ModifierOpStr),
-			FText::AsNumber(ModSpec->GetEvaluatedMagnitude()));
+			FText::AsNumber(Modifier->Magnitude));
 	}
 
 	if (!World)
@@ -97,14 +123,20 @@ FText FGASEffectNode::GetDurationText() const
 	FNumberFormattingOptions NumberFormat;
 	NumberFormat.MaximumFractionalDigits = 2;
 
-	float Duration = GameplayEffect.GetDuration();
-	if (Duration > 0.f)
+	if (Snapshot.Duration > 0.f)
 	{
-		float TimeRemaining = GameplayEffect.GetTimeRemaining(World->GetTimeSeconds());
-		return FText::Format(
-			LOCTEXT("DurationFormat", "Duration: {0}, Remaining: {1}"),
-			FText::AsNumber(Duration, &NumberFormat),
-			FText::AsNumber(TimeRemaining, &NumberFormat));
+		// Read by the text and its tooltip every paint, and unchanged while the game is paused
+		const double WorldTime = World->GetTimeSeconds();
+		if (WorldTime != CachedDurationTime)
+		{
+			CachedDurationTime = WorldTime;
+			const float TimeRemaining = Snapshot.GetTimeRemaining(WorldTime);
+			CachedDurationText = FText::Format(
+				LOCTEXT("DurationFormat", "Duration: {0}, Remaining: {1}"),
+				FText::AsNumber(Snapshot.Duration, &NumberFormat),
+				FText::AsNumber(TimeRemaining, &NumberFormat));
+		}
+		return CachedDurationText;
 	}
 
 	return LOCTEXT("InfiniteDuration", "Infinite Duration");
@@ -112,16 +144,15 @@ FText FGASEffectNode::GetDurationText() const
 
 float FGASEffectNode::GetDurationProgress() const
 {
-	if (ModSpec || !World)
+	if (IsModifierNode() || !World)
 	{
 		return -1.0f; // Not applicable
 	}
 
-	float Duration = GameplayEffect.GetDuration();
-	if (Duration > 0.f)
+	if (Snapshot.Duration > 0.f)
 	{
-		float TimeRemaining = GameplayEffect.GetTimeRemaining(World->GetTimeSeconds());
-		return FMath::Clamp(TimeRemaining / Duration, 0.0f, 1.0f);
+		float TimeRemaining = Snapshot.GetTimeRemaining(World->GetTimeSeconds());
+		return FMath::Clamp(TimeRemaining / Snapshot.Duration, 0.0f, 1.0f);
 	}
 
 	return -1.0f; // Infinite duration
@@ -129,104 +160,114 @@ float FGASEffectNode::GetDurationProgress() const
 
 FText FGASEffectNode::GetStackText() const
 {
-	if (!World || ModSpec)
-	{
-		return FText::GetEmpty();
-	}
+	return CachedStackText;
+}
 
-	int32 StackCount = GameplayEffect.Spec.GetStackCount();
-	if (StackCount > 1)
-	{
-		if (GameplayEffect.Spec.Def)
-		{
-			// Suppress deprecation warning - StackingType will be made private in future versions
-			PRAGMA_DISABLE_DEPRECATION_WARNINGS
-			bool bAggregateBySource = GameplayEffect.Spec.Def->StackingType == EGameplayEffectStackingType::AggregateBySource;
-			PRAGMA_ENABLE_DEPRECATION_WARNINGS
+FName FGASEffectNode::GetLevelStr() const
+{
+	return CachedLevelStr;
+}
 
-			if (bAggregateBySource)
-			{
-				FString SourceName;
-				if (GameplayEffect.Spec.GetContext().GetInstigatorAbilitySystemComponent())
-				{
-					AActor* SourceActor = GameplayEffect.Spec.GetContext().GetInstigatorAbilitySystemComponent()->GetAvatarActor_Direct();
-					SourceName = GetNameSafe(SourceActor);
-				}
-				return FText::Format(
-					LOCTEXT("StackWithSource", "Stacks: {0}, From: {1}"),
-					FText::AsNumber(StackCount),
-					FText::FromString(SourceName));
-			}
-		}
+FText FGASEffectNode::GetPredictionText() const
+{
+	return CachedPredictionText;
+}
 
-		return FText::Format(LOCTEXT("StackCount", "Stacks: {0}"), FText::AsNumber(StackCount));
-	}
+EGASEffectPredictionState FGASEffectNode::GetPredictionState() const
+{
+	return IsModifierNode() ? EGASEffectPredictionState::None : Snapshot.PredictionState;
+}
 
-	return FText::GetEmpty();
+FName FGASEffectNode::GetGrantedTagsName() const
+{
+	return CachedGrantedTags;
 }
 
-FName FGASEffectNode::GetLevelStr() const
+void FGASEffectNode::UpdateCache()
 {
-	if (!World || ModSpec)
+	if (IsModifierNode())
 	{
-		return NAME_None;
+		const FGASModifierSnapshot* Modifier = GetModifier();
+		CachedName = Modifier ? Modifier->AttributeName : NAME_None;
+		return;
 	}
 
-	return *LexToSanitizedString(GameplayEffect.Spec.GetLevel());
-}
+	CachedStackText = FText::GetEmpty();
+	CachedLevelStr = NAME_None;
+	CachedDurationTime = -1.0;
+	CachedPredictionText = FText::GetEmpty();
 
-FText FGASEffectNode::GetPredictionText() const
-{
-	if (!World || ModSpec)
+	if (!World)
 	{
-		return FText::GetEmpty();
+		CachedGrantedTags = NAME_None;
+		return;
 	}
 
-	if (GameplayEffect.PredictionKey.IsValidKey())
+	if (Snapshot.StackCount > 1)
 	{
-		if (GameplayEffect.PredictionKey.WasLocallyGenerated())
+		if (Snapshot.bAggregateBySource)
+		{
+			CachedStackText = FText::Format(
+				LOCTEXT("StackWithSource", "Stacks: {0}, From: {1}"),
+				FText::AsNumber(Snapshot.StackCount),
+				FText::FromName(Snapshot.SourceName));
+		}
+		else
 		{
-			return LOCTEXT("PredictedWaiting", "Predicted and Waiting");
+			CachedStackText = FText::Format(LOCTEXT("StackCount", "Stacks: {0}"), FText::AsNumber(Snapshot.StackCount));
 		}
-		return LOCTEXT("PredictedCaught", "Predicted and Caught Up");
 	}
 
-	return FText::GetEmpty();
-}
+	CachedLevelStr = *LexToSanitizedString(Snapshot.Level);
 
-FName FGASEffectNode::GetGrantedTagsName() const
-{
-	if (!World || ModSpec)
+	switch (Snapshot.PredictionState)
 	{
-		return NAME_None;
+	case EGASEffectPredictionState::Waiting:
+		CachedPredictionText = LOCTEXT("PredictedWaiting", "Predicted and Waiting");
+		break;
+	case EGASEffectPredictionState::CaughtUp:
+		CachedPredictionText = LOCTEXT("PredictedCaught", "Predicted and Caught Up");
+		break;
+	default:
+		break;
 	}
 
-	FGameplayTagContainer GrantedTags;
-	GameplayEffect.Spec.GetAllGrantedTags(GrantedTags);
-
-	if (GrantedTags.IsEmpty())
+	// Granted tags rarely change, only rebuild the string when the indices did
+	if (Snapshot.GrantedTagIndices != PreviousGrantedTagIndices || (CachedGrantedTags.IsNone() && Snapshot.GrantedTagIndices.Num() > 0))
 	{
-		return NAME_None;
+		FString GrantedTagsStr;
+		UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+		for (uint16 NetIndex : Snapshot.GrantedTagIndices)
+		{
+			if (!GrantedTagsStr.IsEmpty())
+			{
+				GrantedTagsStr += TEXT(", ");
+			}
+			GrantedTagsStr += TagsManager.GetTagFromNetIndex(NetIndex).ToString();
+		}
+		CachedGrantedTags = GrantedTagsStr.IsEmpty() ? NAME_None : FName(*GrantedTagsStr);
 	}
-
-	return *GrantedTags.ToStringSimple();
 }
 
 void FGASEffectNode::PopulateModifiers()
 {
-	if (!GameplayEffect.Spec.Def)
+	const int32 NumModifiers = Snapshot.Modifiers.Num();
+
+	// Modifier children are addressed by index, so only the tail ever changes
+	if (Children.Num() > NumModifiers)
 	{
-		return;
+		Children.SetNum(NumModifiers);
 	}
 
-	for (int32 ModIdx = 0; ModIdx < GameplayEffect.Spec.Modifiers.Num(); ++ModIdx)
+	for (const TSharedRef<FGASEffectNodeBase>& Child : Children)
 	{
-		if (ModIdx < GameplayEffect.Spec.Def->Modifiers.Num())
-		{
-			AddChildNode(FGASEffectNode::CreateModifier(
-				&GameplayEffect.Spec.Modifiers[ModIdx],
-				&GameplayEffect.Spec.Def->Modifiers[ModIdx]));
-		}
+		static_cast<FGASEffectNode&>(Child.Get()).UpdateCache();
+	}
+
+	TSharedRef<FGASEffectNode> Self = SharedThis(this);
+	for (int32 ModIdx = Children.Num(); ModIdx < NumModifiers; ++ModIdx)
+	{
+		AddChildNode(FGASEffectNode::CreateModifier(Self, ModIdx));
 	}
 }
 
@@ -242,16 +283,6 @@ void SGASEffectTreeItem::Construct(const FArguments& InArgs, const TSharedRef<ST
 
 	check(NodeInfo.IsValid());
 
-	// Cache data
-	CachedName = NodeInfo->GetName();
-	CachedDurationText = NodeInfo->GetDurationText();
-	CachedDurationProgress = NodeInfo->GetDurationProgress();
-	CachedStackText = NodeInfo->GetStackText();
-	CachedLevelStr = NodeInfo->GetLevelStr();
-	CachedPredictionText = NodeInfo->GetPredictionText();
-	CachedGrantedTags = NodeInfo->GetGrantedTagsName();
-	bIsModifier = NodeInfo->IsModifierNode();
-
 	SMultiColumnTableRow<TSharedRef<FGASEffectNodeBase>>::Construct(
 		SMultiColumnTableRow<TSharedRef<FGASEffectNodeBase>>::FArguments().Padding(0),
 		InOwnerTableView);
@@ -271,15 +302,15 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 				SNew(SBox).HAlign(HAlign_Left).VAlign(VAlign_Center).Padding(FMargin(2.0f, 0.0f))
 				[
 					SNew(STextBlock)
-					.Text(FText::FromName(CachedName))
-					.ToolTipText(FText::FromName(CachedName))
+					.Text(this, &SGASEffectTreeItem::GetNameText)
+					.ToolTipText(this, &SGASEffectTreeItem::GetNameText)
 					.Justification(ETextJustify::Left)
 				]
 			];
 	}
 	else if (ColumnName == GASEffectColumns::Duration)
 	{
-		if (bIsModifier || CachedDurationProgress < 0.0f)
+		if (NodeInfo->IsModifierNode() || NodeInfo->GetDurationProgress() < 0.0f)
 		{
 			// For modifiers or infinite duration, just show text
 			return SNew(SBox)
@@ -288,8 +319,8 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 				.Padding(FMargin(2.0f, 0.0f))
 				[
 					SNew(STextBlock)
-					.Text(CachedDurationText)
-					.ToolTipText(CachedDurationText)
+					.Text(this, &SGASEffectTreeItem::GetDurationText)
+					.ToolTipText(this, &SGASEffectTreeItem::GetDurationText)
 					.Justification(ETextJustify::Left)
 				];
 		}
@@ -366,7 +397,7 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 			.Padding(FMargin(2.0f, 0.0f))
 			[
 				SNew(STextBlock)
-				.Text(CachedStackText)
+				.Text(this, &SGASEffectTreeItem::GetStackText)
 				.Justification(ETextJustify::Left)
 			];
 	}
@@ -378,35 +409,21 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 			.Padding(FMargin(2.0f, 0.0f))
 			[
 				SNew(STextBlock)
-				.Text(FText::FromName(CachedLevelStr))
+				.Text(this, &SGASEffectTreeItem::GetLevelText)
 				.Justification(ETextJustify::Left)
 			];
 	}
 	else if (ColumnName == GASEffectColumns::Prediction)
 	{
-		FLinearColor BorderColor = FLinearColor::Transparent;
-		if (!CachedPredictionText.IsEmpty())
-		{
-			// Determine border color based on prediction state
-			FString PredictionStr = CachedPredictionText.ToString();
-			if (PredictionStr.Contains(TEXT("Waiting")))
-			{
-				BorderColor = FLinearColor::Blue;
-			}
-			else if (PredictionStr.Contains(TEXT("Caught Up")))
-			{
-				BorderColor = FLinearColor::Green;
-			}
-		}
 		return SNew(SBorder)
 			.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
-			.BorderBackgroundColor(FSlateColor(BorderColor))
+			.BorderBackgroundColor(this, &SGASEffectTreeItem::GetPredictionBorderColor)
 			.Padding(FMargin(4.0f, 2.0f))
 			.HAlign(HAlign_Left)
 			.VAlign(VAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(CachedPredictionText)
+				.Text(this, &SGASEffectTreeItem::GetPredictionText)
 				.Justification(ETextJustify::Left)
 			];
 	}
@@ -418,8 +435,8 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 			.Padding(FMargin(2.0f, 0.0f))
 			[
 				SNew(STextBlock)
-				.Text(FText::FromName(CachedGrantedTags))
-				.ToolTipText(FText::FromName(CachedGrantedTags))
+				.Text(this, &SGASEffectTreeItem::GetGrantedTagsText)
+				.ToolTipText(this, &SGASEffectTreeItem::GetGrantedTagsText)
 				.Justification(ETextJustify::Left)
 			];
 	}
@@ -429,4 +446,47 @@ TSharedRef<SWidget> SGASEffectTreeItem::GenerateWidgetForColumn(const FName& Col
 
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
+FText SGASEffectTreeItem::GetNameText() const
+{
+	return FText::FromName(NodeInfo->GetName());
+}
+
+FText SGASEffectTreeItem::GetDurationText() const
+{
+	return NodeInfo->GetDurationText();
+}
+
+FText SGASEffectTreeItem::GetStackText() const
+{
+	return NodeInfo->GetStackText();
+}
+
+FText SGASEffectTreeItem::GetLevelText() const
+{
+	return FText::FromName(NodeInfo->GetLevelStr());
+}
+
+FText SGASEffectTreeItem::GetPredictionText() const
+{
+	return NodeInfo->GetPredictionText();
+}
+
+FSlateColor SGASEffectTreeItem::GetPredictionBorderColor() const
+{
+	switch (NodeInfo->GetPredictionState())
+	{
+	case EGASEffectPredictionState::Waiting:
+		return FSlateColor(FLinearColor::Blue);
+	case EGASEffectPredictionState::CaughtUp:
+		return FSlateColor(FLinearColor::Green);
+	default:
+		return FSlateColor(FLinearColor::Transparent);
+	}
+}
+
+FText SGASEffectTreeItem::GetGrantedTagsText() const
+{
+	return FText::FromName(NodeInfo->GetGrantedTagsName());
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayEffect.h"
 #include "ActiveGameplayEffectHandle.h"
+#include "GASDebuggerTypes.h"
 #include "Widgets/Views/STableViewBase.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/STreeView.h"
@@ -47,16 +48,25 @@ public:
 	/** Get prediction text */
 	virtual FText GetPredictionText() const = 0;
 
+	/** Get prediction state */
+	virtual EGASEffectPredictionState GetPredictionState() const = 0;
+
 	/** Get granted tags as name */
 	virtual FName GetGrantedTagsName() const = 0;
 
 	/** Is this a modifier node (child) */
 	virtual bool IsModifierNode() const = 0;
 
+	/** Cheap check for the expander arrow, answered without building the children */
+	virtual bool MayHaveChildren() const { return Children.Num() > 0; }
+
+	/** Build or refresh the children if the node changed since they were last built */
+	virtual void UpdateChildren() {}
+
 	/** Add a child node */
 	void AddChildNode(TSharedRef<FGASEffectNodeBase> InChild);
 
-	/** Get children */
+	/** Get children as of the last UpdateChildren */
 	const TArray<TSharedRef<FGASEffectNodeBase>>& GetChildren() const { return Children; }
 
 protected:
@@ -74,12 +84,21 @@ public:
 	/** Create an effect node */
 	static TSharedRef<FGASEffectNode> Create(
 		const UWorld* InWorld,
-		const FActiveGameplayEffect& InEffect);
+		const FGASEffectSnapshot& InSnapshot);
 
-	/** Create a modifier node */
+	/** Create a modifier node reading the ModifierIndex-th modifier of its parent effect */
 	static TSharedRef<FGASEffectNode> CreateModifier(
-		const FModifierSpec* InModSpec,
-		const FGameplayModifierInfo* InModInfo);
+		const TSharedRef<FGASEffectNode>& InParent,
+		int32 InModifierIndex);
+
+	/** Refresh this node in place from a captured effect, modifier children are refreshed by the next UpdateChildren */
+	void Update(const UWorld* InWorld, const FGASEffectSnapshot& InSnapshot);
+
+	/** Get the handle identifying this effect */
+	FActiveGameplayEffectHandle GetHandle() const { return Snapshot.Handle; }
+
+	/** Get the data extracted on the last refresh */
+	const FGASEffectSnapshot& GetSnapshot() const { return Snapshot; }
 
 	// FGASEffectNodeBase interface
 	virtual FName GetName() const override;
@@ -88,26 +107,53 @@ public:
 	virtual FText GetStackText() const override;
 	virtual FName GetLevelStr() const override;
 	virtual FText GetPredictionText() const override;
+	virtual EGASEffectPredictionState GetPredictionState() const override;
 	virtual FName GetGrantedTagsName() const override;
-	virtual bool IsModifierNode() const override { return ModSpec != nullptr; }
+	virtual bool IsModifierNode() const override { return ModifierIndex != INDEX_NONE; }
+	virtual bool MayHaveChildren() const override { return !IsModifierNode() && Snapshot.Modifiers.Num() > 0; }
+	virtual void UpdateChildren() override;
 
 private:
-	explicit FGASEffectNode(
-		const UWorld* InWorld,
-		const FActiveGameplayEffect& InEffect);
+	explicit FGASEffectNode(const UWorld* InWorld);
 
 	explicit FGASEffectNode(
-		const FModifierSpec* InModSpec,
-		const FGameplayModifierInfo* InModInfo);
+		const TSharedRef<FGASEffectNode>& InParent,
+		int32 InModifierIndex);
 
-	/** Populate modifiers as children */
+	/** Match modifier children to the modifiers of the current snapshot */
 	void PopulateModifiers();
 
+	/** Cache display data that only changes on refresh */
+	void UpdateCache();
+
+	/** Get the modifier of a modifier node, null when the parent no longer has it */
+	const FGASModifierSnapshot* GetModifier() const;
+
 private:
 	const UWorld* World = nullptr;
-	FActiveGameplayEffect GameplayEffect;
-	const FModifierSpec* ModSpec = nullptr;
-	const FGameplayModifierInfo* ModInfo = nullptr;
+	FGASEffectSnapshot Snapshot;
+
+	/** Granted tags of the previous refresh, to rebuild the tags string only on change */
+	TArray<uint16, TInlineAllocator<8>> PreviousGrantedTagIndices;
+
+	/** Modifier nodes index into the parent's snapshot, which is updated in place */
+	TWeakPtr<FGASEffectNode> ParentNode;
+	int32 ModifierIndex = INDEX_NONE;
+
+	/** Incremented by every Update, modifier children are rebuilt when they are older */
+	uint32 Generation = 0;
+	uint32 ChildrenGeneration = 0;
+
+	// Cached display data
+	FName CachedName;
+	FText CachedStackText;
+	FName CachedLevelStr;
+	FText CachedPredictionText;
+	FName CachedGrantedTags;
+
+	/** Remaining time text, reformatted only when the world time moved since the last read */
+	mutable FText CachedDurationText;
+	mutable double CachedDurationTime = -1.0;
 };
 
 /** Tree row widget for effects */
@@ -125,15 +171,15 @@ public:
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
 
 private:
-	TSharedPtr<FGASEffectNodeBase> NodeInfo;
+	FText GetNameText() const;
+	FText GetDurationText() const;
+	FText GetStackText() const;
+	FText GetLevelText() const;
+	FText GetPredictionText() const;
+	FSlateColor GetPredictionBorderColor() const;
+	FText GetGrantedTagsText() const;
 
-	// Cached data
-	FName CachedName;
-	FText CachedDurationText;
-	float CachedDurationProgress = -1.0f;
-	FText CachedStackText;
-	FName CachedLevelStr;
-	FText CachedPredictionText;
-	FName CachedGrantedTags;
-	bool bIsModifier = false;
+private:
+	/** Nodes are updated in place on refresh, so every column reads from the node instead of caching at construction */
+	TSharedPtr<FGASEffectNodeBase> NodeInfo;
 };
@@ -1,24 +1,68 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Widgets/TreeNodes/GASTagTreeNode.h"
+#include "Core/GASDebuggerStats.h"
 #include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Widgets/Views/SExpanderArrow.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
 
 #define LOCTEXT_NAMESPACE "GASTagTreeNode"
 
 void FGASTagNodeBase::AddChildNode(TSharedRef<FGASTagNodeBase> InChild)
 {
-	Children.Add(InChild);
+	const FName ChildName = InChild->GetTagName();
+	const int32 Index = Algo::LowerBound(Children, ChildName, [](const TSharedRef<FGASTagNodeBase>& Child, const FName& Name)
+	{
+		return Child->GetTagName().Compare(Name) < 0;
+	});
+
+	Children.Insert(InChild, Index);
+	ChildrenByName.Add(ChildName, InChild);
+}
+
+void FGASTagNodeBase::RemoveChild(const FName& ChildName)
+{
+	if (ChildrenByName.Remove(ChildName) > 0)
+	{
+		// Children are sorted by name, the same search AddChildNode inserted with finds the child
+		const int32 Index = Algo::LowerBound(Children, ChildName, [](const TSharedRef<FGASTagNodeBase>& Child, const FName& Name)
+		{
+			return Child->GetTagName().Compare(Name) < 0;
+		});
+		check(Children.IsValidIndex(Index) && Children[Index]->GetTagName() == ChildName);
+		Children.RemoveAt(Index);
+	}
+}
+
+void FGASTagNodeBase::TakeChildren(FGASTagNodeBase& Other)
+{
+	for (const TSharedRef<FGASTagNodeBase>& Child : Other.Children)
+	{
+		AddChildNode(Child);
+	}
+
+	Other.Children.Reset();
+	Other.ChildrenByName.Reset();
+	Other.FilteredChildren.Reset();
+}
+
+TSharedPtr<FGASTagNodeBase> FGASTagNodeBase::FindChild(const FName& ChildName) const
+{
+	const TSharedRef<FGASTagNodeBase>* Child = ChildrenByName.Find(ChildName);
+	return Child ? TSharedPtr<FGASTagNodeBase>(*Child) : nullptr;
 }
 
 TSharedRef<FGASTagNodeBase> FGASTagNodeBase::FindOrCreateChild(const FName& ChildName)
 {
 	// Check if child already exists
-	for (const TSharedRef<FGASTagNodeBase>& Child : Children)
+	if (const TSharedRef<FGASTagNodeBase>* Child = ChildrenByName.Find(ChildName))
 	{
-		if (Child->GetTagName() == ChildName)
-		{
-			return Child;
-		}
+		return *Child;
 	}
 
 	// Create new group node
@@ -30,7 +74,7 @@ TSharedRef<FGASTagNodeBase> FGASTagNodeBase::FindOrCreateChild(const FName& Chil
 	NewPath += ChildName.ToString();
 
 	TSharedRef<FGASTagGroupNode> NewChild = FGASTagGroupNode::Create(ChildName, NewPath);
-	Children.Add(NewChild);
+	AddChildNode(NewChild);
 	return NewChild;
 }
 
@@ -41,22 +85,24 @@ bool FGASTagNodeBase::MatchesFilter(const FString& FilterText) const
 		return true;
 	}
 
-	FString FullPath = GetFullPath();
-	FString TagName = GetTagName().ToString();
-	
-	// For group nodes, also check if any child matches
-	if (IsGroupNode() && !Children.IsEmpty())
+	return GetFullPath().Contains(FilterText);
+}
+
+bool FGASTagNodeBase::UpdateFilter(const FString& FilterText, bool bParentMatches)
+{
+	const bool bMatches = bParentMatches || MatchesFilter(FilterText);
+
+	// Each descendant is evaluated exactly once, its result is memoized in the parent's filtered children
+	FilteredChildren.Reset();
+	for (const TSharedRef<FGASTagNodeBase>& Child : Children)
 	{
-		for (const TSharedRef<FGASTagNodeBase>& Child : Children)
+		if (Child->UpdateFilter(FilterText, bMatches))
 		{
-			if (Child->MatchesFilter(FilterText))
-			{
-				return true;
-			}
+			FilteredChildren.Add(Child);
 		}
 	}
-	
-	return FullPath.Contains(FilterText) || TagName.Contains(FilterText);
+
+	return bMatches || FilteredChildren.Num() > 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -64,6 +110,7 @@ bool FGASTagNodeBase::MatchesFilter(const FString& FilterText) const
 
 TSharedRef<FGASTagGroupNode> FGASTagGroupNode::Create(const FName& InGroupName, const FString& InFullPath)
 {
+	GASDEBUGGER_COUNT_NODE(FGASTagGroupNode);
 	return MakeShared<FGASTagGroupNode>(InGroupName, InFullPath);
 }
 
@@ -81,30 +128,246 @@ FText FGASTagGroupNode::GetDisplayText() const
 //////////////////////////////////////////////////////////////////////////
 // FGASTagNode
 
-TSharedRef<FGASTagNode> FGASTagNode::Create(const FGameplayTag& InTag)
+TSharedRef<FGASTagNode> FGASTagNode::Create(const FGameplayTag& InTag, const FName& InSimpleName)
 {
-	return MakeShared<FGASTagNode>(InTag);
+	GASDEBUGGER_COUNT_NODE(FGASTagNode);
+	return MakeShared<FGASTagNode>(InTag, InSimpleName);
 }
 
-FGASTagNode::FGASTagNode(const FGameplayTag& InTag)
+FGASTagNode::FGASTagNode(const FGameplayTag& InTag, const FName& InSimpleName)
 	: Tag(InTag)
+	, SimpleName(InSimpleName)
+	, FullPath(InTag.ToString())
+	, CachedDisplayText(FText::FromName(InSimpleName))
 {
 }
 
-FText FGASTagNode::GetDisplayText() const
+//////////////////////////////////////////////////////////////////////////
+// FGASTagTree
+
+FGASTagTree::FGASTagTree()
+	: Root(FGASTagGroupNode::Create(NAME_None, FString()))
 {
-	FString TagStr = Tag.ToString();
-	FString DisplayName = Tag.GetTagName().ToString();
-	
-	// Extract the last part of the tag path as display name
-	int32 LastDot = TagStr.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
-	if (LastDot != INDEX_NONE)
+}
+
+TSharedPtr<FGASTagNode> FGASTagTree::AddTag(const FGameplayTag& Tag, TArray<TSharedRef<FGASTagNodeBase>>& OutNewNodes)
+{
+	if (const TSharedRef<FGASTagNode>* ExistingTag = TagNodes.Find(Tag))
+	{
+		return *ExistingTag;
+	}
+
+	TArray<FName, TInlineAllocator<8>> Path;
+	if (!GetTagPath(Tag, Path))
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FGASTagNodeBase> Parent = Root;
+	for (int32 Index = 0; Index < Path.Num() - 1; ++Index)
+	{
+		TSharedPtr<FGASTagNodeBase> Child = Parent->FindChild(Path[Index]);
+		if (!Child.IsValid())
+		{
+			Child = Parent->FindOrCreateChild(Path[Index]);
+			OutNewNodes.Add(Child.ToSharedRef());
+		}
+		Parent = Child.ToSharedRef();
+	}
+
+	const FName LeafName = Path.Last();
+	TSharedRef<FGASTagNode> TagNode = FGASTagNode::Create(Tag, LeafName);
+	if (const TSharedPtr<FGASTagNodeBase> Existing = Parent->FindChild(LeafName))
 	{
-		DisplayName = TagStr.Mid(LastDot + 1);
+		// A child tag was added first, the tag node takes over its group node
+		TagNode->TakeChildren(*Existing);
+		Parent->RemoveChild(LeafName);
 	}
 
-	return FText::FromString(DisplayName);
+	Parent->AddChildNode(TagNode);
+	TagNodes.Add(Tag, TagNode);
+	OutNewNodes.Add(TagNode);
+	return TagNode;
 }
 
-#undef LOCTEXT_NAMESPACE
+void FGASTagTree::RemoveTag(const FGameplayTag& Tag, TArray<TSharedRef<FGASTagNodeBase>>& OutNewNodes)
+{
+	TArray<FName, TInlineAllocator<8>> Path;
+	if (TagNodes.Remove(Tag) == 0 || !GetTagPath(Tag, Path))
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FGASTagNodeBase>, TInlineAllocator<8>> Chain;
+	Chain.Add(Root);
+	for (const FName& Segment : Path)
+	{
+		TSharedPtr<FGASTagNodeBase> Child = Chain.Last()->FindChild(Segment);
+		if (!Child.IsValid())
+		{
+			return;
+		}
+		Chain.Add(Child.ToSharedRef());
+	}
+
+	const TSharedRef<FGASTagNodeBase> Node = Chain.Pop();
+	if (Node->IsGroupNode())
+	{
+		return;
+	}
+
+	Chain.Last()->RemoveChild(Node->GetTagName());
 
+	if (Node->GetChildren().Num() > 0)
+	{
+		// Child tags are still owned, keep them under a group node
+		TSharedRef<FGASTagGroupNode> Group = FGASTagGroupNode::Create(Node->GetTagName(), Node->GetFullPath());
+		Group->TakeChildren(*Node);
+		Chain.Last()->AddChildNode(Group);
+		OutNewNodes.Add(Group);
+		return;
+	}
+
+	// Prune the group nodes left empty
+	while (Chain.Num() > 1)
+	{
+		const TSharedRef<FGASTagNodeBase> Current = Chain.Pop();
+		if (!Current->IsGroupNode() || Current->GetChildren().Num() > 0)
+		{
+			break;
+		}
+		Chain.Last()->RemoveChild(Current->GetTagName());
+	}
+}
+
+TSharedPtr<FGASTagNode> FGASTagTree::FindTag(const FGameplayTag& Tag) const
+{
+	const TSharedRef<FGASTagNode>* TagNode = TagNodes.Find(Tag);
+	return TagNode ? TSharedPtr<FGASTagNode>(*TagNode) : nullptr;
+}
+
+void FGASTagTree::Reset()
+{
+	Root = FGASTagGroupNode::Create(NAME_None, FString());
+	TagNodes.Reset();
+}
+
+void FGASTagTree::ApplyFilter(const FString& FilterText)
+{
+	Root->UpdateFilter(FilterText, false);
+}
+
+bool FGASTagTree::GetTagPath(const FGameplayTag& Tag, TArray<FName, TInlineAllocator<8>>& OutPath)
+{
+	OutPath.Reset();
+
+	const UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+	for (FGameplayTag Current = Tag; Current.IsValid(); Current = Current.RequestDirectParent())
+	{
+		const TSharedPtr<FGameplayTagNode> TagNode = Manager.FindTagNode(Current);
+		if (!TagNode.IsValid())
+		{
+			return false;
+		}
+		OutPath.Add(TagNode->GetSimpleTagName());
+	}
+
+	Algo::Reverse(OutPath);
+	return OutPath.Num() > 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SGASTagTreeItem
+
+void SGASTagTreeItem::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+{
+	NodeInfo = InArgs._NodeInfo;
+
+	check(NodeInfo.IsValid());
+
+	const bool bIsGroupNode = NodeInfo->IsGroupNode();
+
+	TSharedRef<SWidget> Label = SNew(STextBlock)
+		.Text(NodeInfo->GetDisplayText())
+		.HighlightText(InArgs._HighlightText)
+		.ToolTipText(FText::FromString(NodeInfo->GetFullPath()))
+		.ColorAndOpacity(this, &SGASTagTreeItem::GetLabelColor);
+
+	if (!bIsGroupNode)
+	{
+		Label = SNew(SBorder)
+			.Padding(FMargin(4.f, 2.f))
+			.BorderBackgroundColor(FSlateColor(InArgs._TagColor))
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.f, 0.f, 2.f, 0.f)
+				[
+					SNew(STextBlock)
+					.Text(this, &SGASTagTreeItem::GetChangeText)
+					.ColorAndOpacity(this, &SGASTagTreeItem::GetChangeColor)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					Label
+				]
+			];
+	}
+
+	STableRow<TSharedRef<FGASTagNodeBase>>::Construct(
+		STableRow<TSharedRef<FGASTagNodeBase>>::FArguments()
+		.Padding(0)
+		.Content()
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SExpanderArrow, SharedThis(this))
+				.IndentAmount(16)
+				.ShouldDrawWires(true)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(2.f)
+			[
+				Label
+			]
+		],
+		InOwnerTableView);
+}
+
+FText SGASTagTreeItem::GetChangeText() const
+{
+	static const FText AddedText = FText::AsCultureInvariant(TEXT("+"));
+	static const FText RemovedText = FText::AsCultureInvariant(TEXT("\u2212"));
+
+	switch (NodeInfo->GetChange())
+	{
+	case EGASTagChange::Added:
+		return AddedText;
+	case EGASTagChange::Removed:
+		return RemovedText;
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+FSlateColor SGASTagTreeItem::GetChangeColor() const
+{
+	return NodeInfo->GetChange() == EGASTagChange::Removed ? FLinearColor(1.f, 0.3f, 0.3f) : FLinearColor(0.3f, 1.f, 0.3f);
+}
+
+FSlateColor SGASTagTreeItem::GetLabelColor() const
+{
+	if (NodeInfo->IsGroupNode() || NodeInfo->GetChange() == EGASTagChange::Removed)
+	{
+		return FLinearColor::Gray;
+	}
+	return FSlateColor::UseForeground();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -4,6 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Widgets/Views/STableRow.h"
+
+/** How a tag changed in the last update of its container */
+enum class EGASTagChange : uint8
+{
+	None,
+	Added,
+	Removed
+};
 
 /** Base class for tag tree nodes */
 class FGASTagNodeBase
@@ -11,34 +20,58 @@ class FGASTagNodeBase
 public:
 	virtual ~FGASTagNodeBase() {}
 
-	/** Get tag name */
+	/** Get the last segment of the tag path, used as the child key */
 	virtual FName GetTagName() const = 0;
 
 	/** Get display text */
 	virtual FText GetDisplayText() const = 0;
 
-	/** Get full tag path */
-	virtual FString GetFullPath() const = 0;
+	/** Get full tag path, kept by the node so filtering does not build it again */
+	virtual const FString& GetFullPath() const = 0;
 
 	/** Check if this is a group node (not an actual tag) */
 	virtual bool IsGroupNode() const { return false; }
 
-	/** Add a child node */
+	/** Get the change highlighted on this node */
+	virtual EGASTagChange GetChange() const { return EGASTagChange::None; }
+
+	/** Add a child node, children are kept sorted by name */
 	void AddChildNode(TSharedRef<FGASTagNodeBase> InChild);
 
+	/** Remove a child node by name */
+	void RemoveChild(const FName& ChildName);
+
+	/** Move every child of another node to this node */
+	void TakeChildren(FGASTagNodeBase& Other);
+
 	/** Get children */
 	const TArray<TSharedRef<FGASTagNodeBase>>& GetChildren() const { return Children; }
 
+	/** Find a child node by name */
+	TSharedPtr<FGASTagNodeBase> FindChild(const FName& ChildName) const;
+
 	/** Find or create child node by name */
 	TSharedRef<FGASTagNodeBase> FindOrCreateChild(const FName& ChildName);
 
-	/** Check if node matches search filter */
+	/** Check if this node alone matches search filter */
 	virtual bool MatchesFilter(const FString& FilterText) const;
 
+	/**
+	 * Recompute the filter state of this subtree in one bottom-up pass.
+	 * @param bParentMatches Descendants of a matching node are always shown
+	 * @return Whether this node stays visible
+	 */
+	bool UpdateFilter(const FString& FilterText, bool bParentMatches);
+
+	/** Children that passed the last UpdateFilter */
+	const TArray<TSharedRef<FGASTagNodeBase>>& GetFilteredChildren() const { return FilteredChildren; }
+
 protected:
 	FGASTagNodeBase() {}
 
 	TArray<TSharedRef<FGASTagNodeBase>> Children;
+	TMap<FName, TSharedRef<FGASTagNodeBase>> ChildrenByName;
+	TArray<TSharedRef<FGASTagNodeBase>> FilteredChildren;
 };
 
 /** Group node (intermediate node in hierarchy, not an actual tag) */
@@ -49,7 +82,7 @@ public:
 
 	virtual FName GetTagName() const override { return GroupName; }
 	virtual FText GetDisplayText() const override;
-	virtual FString GetFullPath() const override { return FullPath; }
+	virtual const FString& GetFullPath() const override { return FullPath; }
 	virtual bool IsGroupNode() const override { return true; }
 
 public:
@@ -64,18 +97,89 @@ private:
 class FGASTagNode : public FGASTagNodeBase
 {
 public:
-	static TSharedRef<FGASTagNode> Create(const FGameplayTag& InTag);
+	static TSharedRef<FGASTagNode> Create(const FGameplayTag& InTag, const FName& InSimpleName);
 
-	virtual FName GetTagName() const override { return Tag.GetTagName(); }
-	virtual FText GetDisplayText() const override;
-	virtual FString GetFullPath() const override { return Tag.ToString(); }
+	virtual FName GetTagName() const override { return SimpleName; }
+	virtual FText GetDisplayText() const override { return CachedDisplayText; }
+	virtual const FString& GetFullPath() const override { return FullPath; }
+
+	virtual EGASTagChange GetChange() const override { return Change; }
 
 	const FGameplayTag& GetTag() const { return Tag; }
 
+	void SetChange(EGASTagChange InChange) { Change = InChange; }
+
 public:
-	explicit FGASTagNode(const FGameplayTag& InTag);
+	explicit FGASTagNode(const FGameplayTag& InTag, const FName& InSimpleName);
 
 private:
 	FGameplayTag Tag;
+	FName SimpleName;
+	FString FullPath;
+	FText CachedDisplayText;
+	EGASTagChange Change = EGASTagChange::None;
+};
+
+/**
+ * Tag tree rooted at an invisible group node.
+ * Tags are inserted and removed one by one, intermediate group nodes are created and pruned as needed.
+ */
+class FGASTagTree
+{
+public:
+	FGASTagTree();
+
+	/**
+	 * Insert a tag
+	 * @param OutNewNodes Receives the nodes that were created or replaced
+	 * @return The node of the tag, null if the tag is unknown
+	 */
+	TSharedPtr<FGASTagNode> AddTag(const FGameplayTag& Tag, TArray<TSharedRef<FGASTagNodeBase>>& OutNewNodes);
+
+	/** Remove a tag, returns the group node created when its child tags are kept */
+	void RemoveTag(const FGameplayTag& Tag, TArray<TSharedRef<FGASTagNodeBase>>& OutNewNodes);
+
+	/** Find the node of a tag */
+	TSharedPtr<FGASTagNode> FindTag(const FGameplayTag& Tag) const;
+
+	/** Drop every node */
+	void Reset();
+
+	/** Recompute the filter state of all nodes */
+	void ApplyFilter(const FString& FilterText);
+
+	/** Top level nodes that passed the last filter */
+	const TArray<TSharedRef<FGASTagNodeBase>>& GetFilteredRootNodes() const { return Root->GetFilteredChildren(); }
+
+private:
+	/** Resolve the path segments of a tag, root first */
+	static bool GetTagPath(const FGameplayTag& Tag, TArray<FName, TInlineAllocator<8>>& OutPath);
+
+	TSharedRef<FGASTagGroupNode> Root;
+	TMap<FGameplayTag, TSharedRef<FGASTagNode>> TagNodes;
 };
 
+/** Tree row widget for tags */
+class SGASTagTreeItem : public STableRow<TSharedRef<FGASTagNodeBase>>
+{
+public:
+	SLATE_BEGIN_ARGS(SGASTagTreeItem)
+		: _NodeInfo()
+		, _TagColor(FLinearColor::White)
+	{}
+		SLATE_ARGUMENT(TSharedPtr<FGASTagNodeBase>, NodeInfo)
+		SLATE_ARGUMENT(FLinearColor, TagColor)
+		SLATE_ATTRIBUTE(FText, HighlightText)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView);
+
+private:
+	FText GetChangeText() const;
+	FSlateColor GetChangeColor() const;
+	FSlateColor GetLabelColor() const;
+
+private:
+	/** Nodes are reused across updates, change markers read from the node instead of caching at construction */
+	TSharedPtr<FGASTagNodeBase> NodeInfo;
+};
@@ -7,6 +7,7 @@
 
 class FGASDebuggerSharedState;
 class FGASDebuggerWindowInstance;
+class FGASWorldService;
 class FTabManager;
 
 class FGASDebuggerModule : public IModuleInterface
@@ -28,6 +29,9 @@ public:
 	/** Get window instance by ID */
 	TSharedPtr<FGASDebuggerWindowInstance> GetWindowInstance(int32 InstanceId) const;
 
+	/** World lookups and ASC registries shared by all windows */
+	FGASWorldService& GetWorldService() const;
+
 	/** Get all active window instances */
 	const TMap<int32, TSharedPtr<FGASDebuggerWindowInstance>>& GetWindowInstances() const { return WindowInstances; }
 
@@ -57,6 +61,9 @@ private:
 	/** Command list for UI actions */
 	TSharedPtr<class FUICommandList> PluginCommands;
 
+	/** World lookups and ASC registries shared by all windows */
+	TSharedPtr<FGASWorldService> WorldService;
+
 	/** Multi-window management */
 	TMap<int32, TSharedPtr<FGASDebuggerWindowInstance>> WindowInstances;
 	int32 NextInstanceId = 0;
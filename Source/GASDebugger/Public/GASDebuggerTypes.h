@@ -19,6 +19,19 @@ enum class EGASDebugCategory : uint8
 	Ability
 };
 
+/** Bit of a category inside a dirty category mask */
+constexpr uint8 GASDebugCategoryBit(EGASDebugCategory Category)
+{
+	return static_cast<uint8>(1 << static_cast<uint8>(Category));
+}
+
+/** Dirty category mask with every category set */
+constexpr uint8 GASDebugAllCategories =
+	GASDebugCategoryBit(EGASDebugCategory::Tags) |
+	GASDebugCategoryBit(EGASDebugCategory::Attributes) |
+	GASDebugCategoryBit(EGASDebugCategory::GameplayEffects) |
+	GASDebugCategoryBit(EGASDebugCategory::Ability);
+
 /**
  * Filter state for ability display
  */
@@ -80,6 +93,164 @@ struct FGASEffectInfo
 	float Level = 0.0f;
 };
 
+/**
+ * Prediction state of an active gameplay effect
+ */
+enum class EGASEffectPredictionState : uint8
+{
+	None,       // Not predicted
+	Waiting,    // Predicted locally, waiting for the server
+	CaughtUp    // Predicted and confirmed by the server
+};
+
+/**
+ * Evaluated modifier of an active gameplay effect
+ */
+struct FGASModifierSnapshot
+{
+	/** Name of the modified attribute */
+	FName AttributeName;
+
+	/** Modifier operation type */
+	EGameplayModOp::Type Operation = EGameplayModOp::Additive;
+
+	/** Evaluated magnitude */
+	float Magnitude = 0.0f;
+};
+
+/**
+ * Displayed data of an active gameplay effect, extracted without copying its spec.
+ * Containers use inline storage so refreshing an existing snapshot usually does not allocate.
+ */
+struct FGASEffectSnapshot
+{
+	/** The active effect handle */
+	FActiveGameplayEffectHandle Handle;
+
+	/** Name of the effect class, without the Blueprint _C suffix */
+	FName EffectClassName;
+
+	/** Effect duration (<= 0 for infinite) */
+	float Duration = 0.0f;
+
+	/** World time the effect started at */
+	float StartWorldTime = 0.0f;
+
+	/** Current stack count */
+	int32 StackCount = 0;
+
+	/** Effect level */
+	float Level = 0.0f;
+
+	/** Stacks aggregate by source, SourceName holds the instigator avatar */
+	bool bAggregateBySource = false;
+	FName SourceName;
+
+	/** Prediction state */
+	EGASEffectPredictionState PredictionState = EGASEffectPredictionState::None;
+
+	/** Net indices of all granted tags */
+	TArray<uint16, TInlineAllocator<8>> GrantedTagIndices;
+
+	/** Evaluated modifiers, in definition order */
+	TArray<FGASModifierSnapshot, TInlineAllocator<4>> Modifiers;
+
+	/** Remaining time at WorldTime (-1 for infinite) */
+	float GetTimeRemaining(float WorldTime) const
+	{
+		return Duration > 0.0f ? Duration - (WorldTime - StartWorldTime) : -1.0f;
+	}
+};
+
+/**
+ * Tags of a container as net indices, sorted by tag name.
+ * Each entry packs the lexical rank of the tag above its net index, so sorting and diffing only compare integers.
+ * Built by FGASDataProvider::CaptureTagSnapshot.
+ */
+struct FGASTagSnapshot
+{
+	/** (LexicalRank << 16) | NetIndex, ascending */
+	TArray<uint32> Entries;
+
+	/** Version of the rank table the entries were keyed with */
+	uint32 RankVersion = 0;
+
+	static uint16 GetNetIndex(uint32 Entry)
+	{
+		return static_cast<uint16>(Entry & 0xFFFF);
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	void Reset()
+	{
+		Entries.Reset();
+	}
+};
+
+/**
+ * Tags of a container as one bit per net index, with the parents of every tag set as well.
+ * Tag queries on it are word-wise AND/OR, built by FGASDataProvider::CaptureTagBitset.
+ */
+struct FGASTagBitset
+{
+	TArray<uint64> Words;
+
+	/** Clear all bits and size for NumBits net indices */
+	void Init(int32 NumBits)
+	{
+		Words.Reset();
+		Words.SetNumZeroed((NumBits + 63) / 64);
+	}
+
+	void SetBit(uint16 NetIndex)
+	{
+		const int32 WordIndex = NetIndex >> 6;
+		if (WordIndex >= Words.Num())
+		{
+			Words.SetNumZeroed(WordIndex + 1);
+		}
+		Words[WordIndex] |= uint64(1) << (NetIndex & 63);
+	}
+
+	bool HasBit(uint16 NetIndex) const
+	{
+		const int32 WordIndex = NetIndex >> 6;
+		return Words.IsValidIndex(WordIndex) && (Words[WordIndex] & (uint64(1) << (NetIndex & 63))) != 0;
+	}
+
+	/** Every bit of Mask is set, an empty mask always matches */
+	bool HasAll(const FGASTagBitset& Mask) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Mask.Words.Num(); ++WordIndex)
+		{
+			const uint64 Word = Words.IsValidIndex(WordIndex) ? Words[WordIndex] : 0;
+			if ((Word & Mask.Words[WordIndex]) != Mask.Words[WordIndex])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** At least one bit of Mask is set */
+	bool HasAny(const FGASTagBitset& Mask) const
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Mask.Words.Num());
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			if ((Words[WordIndex] & Mask.Words[WordIndex]) != 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
 /**
  * Information about a gameplay attribute
  */
@@ -88,6 +259,9 @@ struct FGASAttributeInfo
 	/** The attribute */
 	FGameplayAttribute Attribute;
 
+	/** Attribute name, read on the game thread so the info can be used by other threads */
+	FName AttributeName;
+
 	/** Base value */
 	float BaseValue = 0.0f;
 
@@ -112,6 +286,55 @@ struct FGASModifierInfo
 	/** Source effect class */
 	TSubclassOf<class UGameplayEffect> SourceEffectClass;
 
+	/** Source effect class name, read on the game thread so the info can be used by other threads */
+	FName SourceEffectName;
+
 	/** Stack count from source */
 	int32 StackCount = 0;
 };
+
+/**
+ * Modifiers of all active effects grouped by the attribute they modify.
+ * Built in a single pass over the active effects, see FGASDataProvider::BuildAttributeModifierIndex.
+ */
+struct FGASAttributeModifierIndex
+{
+	TMap<FGameplayAttribute, TArray<FGASModifierInfo>> Modifiers;
+
+	/** Get the modifiers of an attribute, null when nothing modifies it */
+	const TArray<FGASModifierInfo>* Find(const FGameplayAttribute& Attribute) const
+	{
+		return Modifiers.Find(Attribute);
+	}
+
+	void Reset()
+	{
+		Modifiers.Reset();
+	}
+};
+
+/**
+ * Change counters of the ASC state that ability activation depends on.
+ * Ability nodes remember the counters their state was computed from and only call
+ * CanActivateAbility again once one of them moved, see FGASAbilityNode::Update.
+ */
+struct FGASAbilityStateVersions
+{
+	/** Owned tags, cooldowns are tag checks so cooldown effects show up here through their granted tags */
+	uint32 OwnedTags = 0;
+
+	/** Blocked ability tags */
+	uint32 BlockedTags = 0;
+
+	/** Active effects added or removed, keeps cooldown start time and duration current */
+	uint32 Effects = 0;
+
+	/** Per attribute change counters, attributes that never changed have no entry */
+	const TMap<FGameplayAttribute, uint32>* Attributes = nullptr;
+
+	uint32 GetAttributeVersion(const FGameplayAttribute& Attribute) const
+	{
+		const uint32* Version = Attributes ? Attributes->Find(Attribute) : nullptr;
+		return Version ? *Version : 0;
+	}
+};
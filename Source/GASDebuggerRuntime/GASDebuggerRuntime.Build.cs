@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class GASDebuggerRuntime : ModuleRules
+{
+	public GASDebuggerRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine",
+
+			// GAS modules (engine plugins), the public headers derive from their types
+			"GameplayAbilities",
+			"GameplayTags",
+		});
+	}
+}
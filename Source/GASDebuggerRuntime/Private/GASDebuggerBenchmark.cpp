@@ -0,0 +1,140 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "GASDebuggerBenchmark.h"
+#include "GASDebuggerBenchmarkTypes.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "GameplayTagsManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+namespace GASDebuggerBenchmark
+{
+	UWorld* FindBenchmarkWorld(UWorld* PreferredWorld)
+	{
+		if (PreferredWorld && PreferredWorld->IsGameWorld())
+		{
+			return PreferredWorld;
+		}
+
+		// Never the editor world, spawning into it would dirty the level being edited
+		if (GEngine)
+		{
+			for (const FWorldContext& Context : GEngine->GetWorldContexts())
+			{
+				UWorld* World = Context.World();
+				if (World && World->IsGameWorld())
+				{
+					return World;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	UAbilitySystemComponent* SpawnSyntheticASC(UWorld* World)
+	{
+		if (!World)
+		{
+			return nullptr;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParams);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+
+		UAbilitySystemComponent* ASC = NewObject<UAbilitySystemComponent>(Actor, TEXT("BenchmarkASC"), RF_Transient);
+		Actor->AddInstanceComponent(ASC);
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(Actor, Actor);
+		return ASC;
+	}
+
+	void DestroySyntheticASC(UAbilitySystemComponent* ASC)
+	{
+		if (AActor* Actor = ASC ? ASC->GetOwner() : nullptr)
+		{
+			Actor->Destroy();
+		}
+	}
+
+	UGameplayEffect* CreateSyntheticEffect(const FGameplayAttribute& ModifiedAttribute)
+	{
+		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+		Effect->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+		if (ModifiedAttribute.IsValid())
+		{
+			FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+			Modifier.Attribute = ModifiedAttribute;
+			Modifier.ModifierOp = EGameplayModOp::Additive;
+			Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(1.0f));
+		}
+		return Effect;
+	}
+
+	void GetSyntheticTags(int32 Count, TArray<FGameplayTag>& OutTags)
+	{
+		OutTags.Reset();
+
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, true);
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			if (OutTags.Num() >= Count)
+			{
+				break;
+			}
+			OutTags.Add(Tag);
+		}
+	}
+
+	void PopulateSyntheticASC(UAbilitySystemComponent* ASC, const FSyntheticASCConfig& Config, const UGameplayEffect* Effect, TConstArrayView<FGameplayTag> Tags)
+	{
+		if (!ASC)
+		{
+			return;
+		}
+
+		for (int32 Index = 0; Index < Config.Abilities; ++Index)
+		{
+			ASC->GiveAbility(FGameplayAbilitySpec(UGASDebuggerBenchmarkAbility::StaticClass(), 1, INDEX_NONE, Config.AbilitySourceObject));
+		}
+
+		// Before the effects, their modifiers target this set
+		if (Config.bAttributes)
+		{
+			ASC->AddSpawnedAttribute(NewObject<UGASDebuggerBenchmarkAttributeSet>(ASC->GetOwner(), NAME_None, RF_Transient));
+		}
+
+		ApplySyntheticEffects(ASC, Effect, Config.Effects);
+
+		for (int32 Index = 0; Index < FMath::Min(Config.LooseTags, Tags.Num()); ++Index)
+		{
+			ASC->AddLooseGameplayTag(Tags[Index]);
+		}
+	}
+
+	void ApplySyntheticEffects(UAbilitySystemComponent* ASC, const UGameplayEffect* Effect, int32 Count)
+	{
+		if (!ASC || !Effect)
+		{
+			return;
+		}
+
+		const FGameplayEffectContextHandle Context = ASC->MakeEffectContext();
+		for (int32 Index = ASC->GetActiveGameplayEffects().GetNumGameplayEffects(); Index < Count; ++Index)
+		{
+			ASC->ApplyGameplayEffectToSelf(Effect, 1.0f, Context);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "GASDebuggerBenchmarkTypes.h"
+#include "GASDebuggerLoadGenerator.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+FGameplayAttribute UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(int32 Index)
+{
+	if (Index < 0 || Index >= NumValues)
+	{
+		return FGameplayAttribute();
+	}
+
+	FProperty* Property = FindFProperty<FProperty>(StaticClass(), *FString::Printf(TEXT("Value%d"), Index));
+	return FGameplayAttribute(Property);
+}
+
+UGASDebuggerBenchmarkAbility::UGASDebuggerBenchmarkAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerExecution;
+}
+
+void UGASDebuggerBenchmarkAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	const AGASDebuggerLoadGenerator* Generator = Cast<AGASDebuggerLoadGenerator>(GetCurrentSourceObject());
+	const float ActiveSeconds = Generator ? Generator->AbilityActiveSeconds : DefaultActiveSeconds;
+
+	// Native abilities without a graph never end on their own, every execution would leak its instance
+	UWorld* World = GetWorld();
+	if (!World || ActiveSeconds <= 0.0f)
+	{
+		EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+		return;
+	}
+
+	World->GetTimerManager().SetTimer(EndTimerHandle, FTimerDelegate::CreateUObject(this, &UGASDebuggerBenchmarkAbility::HandleActiveTimeElapsed), ActiveSeconds, false);
+}
+
+void UGASDebuggerBenchmarkAbility::HandleActiveTimeElapsed()
+{
+	EndAbility(GetCurrentAbilitySpecHandle(), GetCurrentActorInfo(), GetCurrentActivationInfo(), true, false);
+}
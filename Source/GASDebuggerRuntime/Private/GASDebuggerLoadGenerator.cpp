@@ -0,0 +1,259 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "GASDebuggerLoadGenerator.h"
+#include "GASDebuggerBenchmark.h"
+#include "GASDebuggerBenchmarkTypes.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Parse.h"
+
+namespace GASDebuggerLoadGenerator
+{
+	/** Attributes the effects modify, the attribute churn uses every value */
+	static constexpr int32 PeriodicEffectAttribute = 0;
+	static constexpr int32 DurationEffectAttribute = 1;
+
+	/** Upper bound of a generated attribute base value */
+	static constexpr float MaxAttributeValue = 100.0f;
+}
+
+AGASDebuggerLoadGenerator::AGASDebuggerLoadGenerator()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+}
+
+void AGASDebuggerLoadGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Random.Initialize(Seed);
+	GASDebuggerBenchmark::GetSyntheticTags(TagPoolSize, TagPool);
+
+	PeriodicEffect = GASDebuggerBenchmark::CreateSyntheticEffect(UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(GASDebuggerLoadGenerator::PeriodicEffectAttribute));
+	PeriodicEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	PeriodicEffect->DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(EffectDuration));
+	PeriodicEffect->Period = FScalableFloat(EffectPeriod);
+
+	DurationEffect = GASDebuggerBenchmark::CreateSyntheticEffect(UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(GASDebuggerLoadGenerator::DurationEffectAttribute));
+	DurationEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	DurationEffect->DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(EffectDuration));
+
+	// Only abilities and the attribute set up front, effects and tags come from the churn
+	GASDebuggerBenchmark::FSyntheticASCConfig Config;
+	Config.Abilities = AbilitiesPerASC;
+	Config.Effects = 0;
+	Config.LooseTags = 0;
+	Config.bAttributes = true;
+	Config.AbilitySourceObject = this;
+
+	for (int32 Index = 0; Index < NumASCs; ++Index)
+	{
+		UAbilitySystemComponent* ASC = GASDebuggerBenchmark::SpawnSyntheticASC(GetWorld());
+		if (!ASC)
+		{
+			break;
+		}
+		GASDebuggerBenchmark::PopulateSyntheticASC(ASC, Config, nullptr, TArrayView<const FGameplayTag>());
+		ASCs.Add(ASC);
+	}
+	LooseTags.SetNum(ASCs.Num());
+}
+
+void AGASDebuggerLoadGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UAbilitySystemComponent* ASC : ASCs)
+	{
+		if (IsValid(ASC))
+		{
+			GASDebuggerBenchmark::DestroySyntheticASC(ASC);
+		}
+	}
+	ASCs.Reset();
+	LooseTags.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGASDebuggerLoadGenerator::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (ASCs.Num() == 0)
+	{
+		return;
+	}
+
+	// Fixed order, so the stream is consumed the same way for the same frame times
+	for (int32 Count = ConsumeEvents(AbilityActivationsPerSecond, DeltaSeconds, AbilityAccumulator); Count > 0; --Count)
+	{
+		ActivateRandomAbility();
+	}
+	for (int32 Count = ConsumeEvents(PeriodicEffectsPerSecond, DeltaSeconds, PeriodicEffectAccumulator); Count > 0; --Count)
+	{
+		ApplyRandomEffect(PeriodicEffect);
+	}
+	for (int32 Count = ConsumeEvents(DurationEffectsPerSecond, DeltaSeconds, DurationEffectAccumulator); Count > 0; --Count)
+	{
+		ApplyRandomEffect(DurationEffect);
+	}
+	for (int32 Count = ConsumeEvents(TagChangesPerSecond, DeltaSeconds, TagAccumulator); Count > 0; --Count)
+	{
+		ToggleRandomTag();
+	}
+	for (int32 Count = ConsumeEvents(AttributeChangesPerSecond, DeltaSeconds, AttributeAccumulator); Count > 0; --Count)
+	{
+		ChangeRandomAttribute();
+	}
+}
+
+int32 AGASDebuggerLoadGenerator::ConsumeEvents(float Rate, float DeltaSeconds, double& Accumulator)
+{
+	Accumulator += FMath::Max(Rate, 0.0f) * DeltaSeconds;
+	const int32 Count = FMath::FloorToInt32(Accumulator);
+	Accumulator -= Count;
+	return Count;
+}
+
+int32 AGASDebuggerLoadGenerator::PickASC()
+{
+	const int32 Index = Random.RandRange(0, ASCs.Num() - 1);
+	return IsValid(ASCs[Index]) ? Index : INDEX_NONE;
+}
+
+void AGASDebuggerLoadGenerator::ActivateRandomAbility()
+{
+	const int32 Index = PickASC();
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TArray<FGameplayAbilitySpec>& Specs = ASCs[Index]->GetActivatableAbilities();
+	if (Specs.Num() > 0)
+	{
+		ASCs[Index]->TryActivateAbility(Specs[Random.RandRange(0, Specs.Num() - 1)].Handle);
+	}
+}
+
+void AGASDebuggerLoadGenerator::ApplyRandomEffect(const UGameplayEffect* Effect)
+{
+	const int32 Index = PickASC();
+	if (Index == INDEX_NONE || !Effect)
+	{
+		return;
+	}
+
+	UAbilitySystemComponent* ASC = ASCs[Index];
+	ASC->ApplyGameplayEffectToSelf(Effect, 1.0f, ASC->MakeEffectContext());
+}
+
+void AGASDebuggerLoadGenerator::ToggleRandomTag()
+{
+	const int32 Index = PickASC();
+	if (Index == INDEX_NONE || TagPool.Num() == 0)
+	{
+		return;
+	}
+
+	// Tracked per ASC, the ASC's tag count also includes parents of other tags
+	const FGameplayTag& Tag = TagPool[Random.RandRange(0, TagPool.Num() - 1)];
+	FGameplayTagContainer& Added = LooseTags[Index];
+	if (Added.HasTagExact(Tag))
+	{
+		ASCs[Index]->RemoveLooseGameplayTag(Tag);
+		Added.RemoveTag(Tag);
+	}
+	else
+	{
+		ASCs[Index]->AddLooseGameplayTag(Tag);
+		Added.AddTag(Tag);
+	}
+}
+
+void AGASDebuggerLoadGenerator::ChangeRandomAttribute()
+{
+	const int32 Index = PickASC();
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FGameplayAttribute Attribute = UGASDebuggerBenchmarkAttributeSet::GetValueAttribute(Random.RandRange(0, UGASDebuggerBenchmarkAttributeSet::NumValues - 1));
+	ASCs[Index]->SetNumericAttributeBase(Attribute, Random.FRandRange(0.0f, GASDebuggerLoadGenerator::MaxAttributeValue));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// GASDebugger.LoadGenerator
+
+namespace GASDebuggerLoadGenerator
+{
+	static void RunLoadGeneratorCommand(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+	{
+		UWorld* World = GASDebuggerBenchmark::FindBenchmarkWorld(InWorld);
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger load generator: needs a PIE or game world"));
+			return;
+		}
+
+		// Stop removes every generator of the world, with their ASCs
+		int32 NumStopped = 0;
+		for (TActorIterator<AGASDebuggerLoadGenerator> It(World); It; ++It)
+		{
+			It->Destroy();
+			++NumStopped;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+		{
+			Ar.Logf(TEXT("GASDebugger load generator: stopped %d generators"), NumStopped);
+			return;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.bDeferConstruction = true;
+
+		AGASDebuggerLoadGenerator* Generator = World->SpawnActor<AGASDebuggerLoadGenerator>(SpawnParams);
+		if (!Generator)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDebugger load generator: could not spawn the generator"));
+			return;
+		}
+
+		// Properties are read by BeginPlay, set them before the spawn finishes
+		const FString Line = FString::Join(Args, TEXT(" "));
+		FParse::Value(*Line, TEXT("ASCs="), Generator->NumASCs);
+		FParse::Value(*Line, TEXT("Abilities="), Generator->AbilitiesPerASC);
+		FParse::Value(*Line, TEXT("ActiveSeconds="), Generator->AbilityActiveSeconds);
+		FParse::Value(*Line, TEXT("Tags="), Generator->TagPoolSize);
+		FParse::Value(*Line, TEXT("Seed="), Generator->Seed);
+		FParse::Value(*Line, TEXT("Activations="), Generator->AbilityActivationsPerSecond);
+		FParse::Value(*Line, TEXT("PeriodicEffects="), Generator->PeriodicEffectsPerSecond);
+		FParse::Value(*Line, TEXT("DurationEffects="), Generator->DurationEffectsPerSecond);
+		FParse::Value(*Line, TEXT("TagChanges="), Generator->TagChangesPerSecond);
+		FParse::Value(*Line, TEXT("AttributeChanges="), Generator->AttributeChangesPerSecond);
+		FParse::Value(*Line, TEXT("Duration="), Generator->EffectDuration);
+		FParse::Value(*Line, TEXT("Period="), Generator->EffectPeriod);
+
+		Generator->NumASCs = FMath::Max(Generator->NumASCs, 1);
+		Generator->TagPoolSize = FMath::Max(Generator->TagPoolSize, 1);
+		Generator->EffectDuration = FMath::Max(Generator->EffectDuration, 0.1f);
+		Generator->EffectPeriod = FMath::Max(Generator->EffectPeriod, 0.1f);
+		Generator->AbilityActiveSeconds = FMath::Max(Generator->AbilityActiveSeconds, 0.0f);
+		Generator->FinishSpawning(FTransform::Identity);
+
+		Ar.Logf(TEXT("GASDebugger load generator: %d ASCs with %d abilities, seed %d"), Generator->NumASCs, Generator->AbilitiesPerASC, Generator->Seed);
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadGeneratorCommand(
+		TEXT("GASDebugger.LoadGenerator"),
+		TEXT("Spawn a generator churning the GAS state of synthetic ASCs, replacing the running one. Usage: GASDebugger.LoadGenerator [Stop] [ASCs=64] [Abilities=10] [ActiveSeconds=0.5] [Tags=32] [Seed=1] ")
+		TEXT("[Activations=10] [PeriodicEffects=5] [DurationEffects=20] [TagChanges=50] [AttributeChanges=100] [Duration=5] [Period=1]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunLoadGeneratorCommand));
+}
@@ -0,0 +1,6 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Synthetic GAS load for benchmarks and the load generator, loaded in -game and cooked builds as well
+IMPLEMENT_MODULE(FDefaultModuleImpl, GASDebuggerRuntime)
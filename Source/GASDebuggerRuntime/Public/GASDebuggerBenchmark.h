@@ -0,0 +1,65 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "GameplayTagContainer.h"
+
+class UWorld;
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+/**
+ * Helpers to build synthetic GAS load for the GASDebugger.Benchmark.* console commands and the load generator.
+ * Everything created here is transient and must be released with DestroySyntheticASC.
+ */
+namespace GASDebuggerBenchmark
+{
+	/** Pick the world to run in: the given one if it is a game world, otherwise the first game/PIE world, nullptr without one */
+	GASDEBUGGERRUNTIME_API UWorld* FindBenchmarkWorld(UWorld* PreferredWorld);
+
+	/** Spawn a transient actor owning a registered and initialized ASC */
+	GASDEBUGGERRUNTIME_API UAbilitySystemComponent* SpawnSyntheticASC(UWorld* World);
+
+	/** Destroy the actor owning a synthetic ASC */
+	GASDEBUGGERRUNTIME_API void DestroySyntheticASC(UAbilitySystemComponent* ASC);
+
+	/** Content granted to a synthetic ASC by PopulateSyntheticASC */
+	struct FSyntheticASCConfig
+	{
+		int32 Abilities = 10;
+		int32 Effects = 10;
+		int32 LooseTags = 10;
+
+		/** Grant UGASDebuggerBenchmarkAttributeSet, which has a fixed number of attributes */
+		bool bAttributes = true;
+
+		/** Source object of the granted ability specs, a load generator here sets how long activations last */
+		UObject* AbilitySourceObject = nullptr;
+	};
+
+	/** Create a transient infinite effect definition, adding 1 to ModifiedAttribute when it is valid */
+	GASDEBUGGERRUNTIME_API UGameplayEffect* CreateSyntheticEffect(const FGameplayAttribute& ModifiedAttribute = FGameplayAttribute());
+
+	/** Get up to Count tags of the tag dictionary, synthetic ASCs use them as loose tags */
+	GASDEBUGGERRUNTIME_API void GetSyntheticTags(int32 Count, TArray<FGameplayTag>& OutTags);
+
+	/** Grant abilities, the attribute set, effects and loose tags to a synthetic ASC */
+	GASDEBUGGERRUNTIME_API void PopulateSyntheticASC(UAbilitySystemComponent* ASC, const FSyntheticASCConfig& Config, const UGameplayEffect* Effect, TConstArrayView<FGameplayTag> Tags);
+
+	/** Apply instances of an effect until the ASC holds Count active effects */
+	GASDEBUGGERRUNTIME_API void ApplySyntheticEffects(UAbilitySystemComponent* ASC, const UGameplayEffect* Effect, int32 Count);
+
+	/** Average cost of a callable over Iterations runs, in microseconds */
+	template <typename FunctorType>
+	double TimeMicroseconds(int32 Iterations, FunctorType&& Functor)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Iterations; ++Index)
+		{
+			Functor();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / FMath::Max(Iterations, 1);
+	}
+}
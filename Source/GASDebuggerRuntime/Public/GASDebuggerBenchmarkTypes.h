@@ -0,0 +1,94 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Abilities/GameplayAbility.h"
+#include "GASDebuggerBenchmarkTypes.generated.h"
+
+/** Attribute set granted to synthetic ASCs, its values carry no meaning */
+UCLASS(Transient)
+class GASDEBUGGERRUNTIME_API UGASDebuggerBenchmarkAttributeSet : public UAttributeSet
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumValues = 16;
+
+	/** Get the attribute of Value<Index>, invalid when out of range */
+	static FGameplayAttribute GetValueAttribute(int32 Index);
+
+	UPROPERTY()
+	FGameplayAttributeData Value0;
+
+	UPROPERTY()
+	FGameplayAttributeData Value1;
+
+	UPROPERTY()
+	FGameplayAttributeData Value2;
+
+	UPROPERTY()
+	FGameplayAttributeData Value3;
+
+	UPROPERTY()
+	FGameplayAttributeData Value4;
+
+	UPROPERTY()
+	FGameplayAttributeData Value5;
+
+	UPROPERTY()
+	FGameplayAttributeData Value6;
+
+	UPROPERTY()
+	FGameplayAttributeData Value7;
+
+	UPROPERTY()
+	FGameplayAttributeData Value8;
+
+	UPROPERTY()
+	FGameplayAttributeData Value9;
+
+	UPROPERTY()
+	FGameplayAttributeData Value10;
+
+	UPROPERTY()
+	FGameplayAttributeData Value11;
+
+	UPROPERTY()
+	FGameplayAttributeData Value12;
+
+	UPROPERTY()
+	FGameplayAttributeData Value13;
+
+	UPROPERTY()
+	FGameplayAttributeData Value14;
+
+	UPROPERTY()
+	FGameplayAttributeData Value15;
+};
+
+/**
+ * Ability granted to synthetic ASCs, instanced per execution so granting it creates no objects.
+ * Specs granted by a load generator take their active time from it, others use DefaultActiveSeconds.
+ */
+UCLASS(Transient)
+class GASDEBUGGERRUNTIME_API UGASDebuggerBenchmarkAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UGASDebuggerBenchmarkAbility();
+
+	/** Seconds an activation stays active before it ends itself */
+	static constexpr float DefaultActiveSeconds = 0.5f;
+
+	// UGameplayAbility interface
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+
+private:
+	void HandleActiveTimeElapsed();
+
+	FTimerHandle EndTimerHandle;
+};
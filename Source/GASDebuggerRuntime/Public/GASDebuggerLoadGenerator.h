@@ -0,0 +1,107 @@
+// Copyright Qiu, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagContainer.h"
+#include "Math/RandomStream.h"
+#include "GASDebuggerLoadGenerator.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+/**
+ * Spawns synthetic ASCs on BeginPlay and churns their GAS state every tick: ability activations,
+ * periodic and duration effects, loose tags and attribute base values.
+ * Every choice comes from one random stream, so with a fixed time step (-UseFixedTimeStep -FPS=<n>, or -benchmark)
+ * a seed always produces the same load. Place it in a level, or use GASDebugger.LoadGenerator in PIE and -game runs.
+ * It lives in the runtime module, so levels holding it also load in cooked builds.
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "GAS Debugger Load Generator"))
+class GASDEBUGGERRUNTIME_API AGASDebuggerLoadGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGASDebuggerLoadGenerator();
+
+	UPROPERTY(EditAnywhere, Category = "Load", meta = (ClampMin = "1"))
+	int32 NumASCs = 64;
+
+	UPROPERTY(EditAnywhere, Category = "Load", meta = (ClampMin = "0"))
+	int32 AbilitiesPerASC = 10;
+
+	/** Seconds an ability activation stays active before it ends itself, 0 ends it right away */
+	UPROPERTY(EditAnywhere, Category = "Load", meta = (ClampMin = "0"))
+	float AbilityActiveSeconds = 0.5f;
+
+	/** Loose tags are picked from this many tags of the tag dictionary */
+	UPROPERTY(EditAnywhere, Category = "Load", meta = (ClampMin = "1"))
+	int32 TagPoolSize = 32;
+
+	UPROPERTY(EditAnywhere, Category = "Load")
+	int32 Seed = 1;
+
+	// Rates, events per second over all ASCs
+	UPROPERTY(EditAnywhere, Category = "Rates", meta = (ClampMin = "0"))
+	float AbilityActivationsPerSecond = 10.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Rates", meta = (ClampMin = "0"))
+	float PeriodicEffectsPerSecond = 5.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Rates", meta = (ClampMin = "0"))
+	float DurationEffectsPerSecond = 20.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Rates", meta = (ClampMin = "0"))
+	float TagChangesPerSecond = 50.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Rates", meta = (ClampMin = "0"))
+	float AttributeChangesPerSecond = 100.0f;
+
+	// Effect shape
+	UPROPERTY(EditAnywhere, Category = "Effects", meta = (ClampMin = "0.1"))
+	float EffectDuration = 5.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Effects", meta = (ClampMin = "0.1"))
+	float EffectPeriod = 1.0f;
+
+	// AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	/** Number of events due this tick for a rate, the fractional rest carries over to the next tick */
+	static int32 ConsumeEvents(float Rate, float DeltaSeconds, double& Accumulator);
+
+	/** Index of a random ASC, INDEX_NONE when the picked one was destroyed and the event is dropped */
+	int32 PickASC();
+
+	void ActivateRandomAbility();
+	void ApplyRandomEffect(const UGameplayEffect* Effect);
+	void ToggleRandomTag();
+	void ChangeRandomAttribute();
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAbilitySystemComponent>> ASCs;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UGameplayEffect> PeriodicEffect;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UGameplayEffect> DurationEffect;
+
+	/** Loose tags added by this generator, per ASC, only these are removed again */
+	TArray<FGameplayTagContainer> LooseTags;
+
+	TArray<FGameplayTag> TagPool;
+	FRandomStream Random;
+
+	double AbilityAccumulator = 0.0;
+	double PeriodicEffectAccumulator = 0.0;
+	double DurationEffectAccumulator = 0.0;
+	double TagAccumulator = 0.0;
+	double AttributeAccumulator = 0.0;
+};